@@ -75,12 +75,17 @@ void Direct2DTextureLoader::load(spine::AtlasPage& page, const spine::String& pa
 }
 void Direct2DTextureLoader::unload(void* texture) 
 {
-	// ComPr 삭제
-	m_bitmapMap.clear();
+	// 아틀라스는 캐시에서 개별적으로 해제되므로 해당 비트맵만 삭제
+	for (auto it = m_bitmapMap.begin(); it != m_bitmapMap.end(); ++it) {
+		if (it->second.Get() == texture) {
+			m_bitmapMap.erase(it);
+			break;
+		}
+	}
 }
 
 
-SpineRenderer::SpineRenderer() : m_textureLoader(nullptr), m_atlas(nullptr), m_skeletonData(nullptr), m_skeleton(nullptr), m_stateData(nullptr), m_state(nullptr) {}
+SpineRenderer::SpineRenderer() : m_textureLoader(nullptr), m_skeleton(nullptr), m_state(nullptr) {}
 SpineRenderer::~SpineRenderer() { Shutdown(); }
 
 bool SpineRenderer::Initialize(HWND hwnd, int width, int height) {
@@ -108,6 +113,7 @@ bool SpineRenderer::Initialize(HWND hwnd, int width, int height) {
 	}
 
 	m_textureLoader = std::make_unique<Direct2DTextureLoader>(m_renderTarget.Get());
+	m_assetCache = std::make_unique<spine::SpineAssetCache>(m_textureLoader.get());
 
 	// spine-cpp 기반 Spine 데이터 로드
 	if (!LoadSpine("../Resource/spineboy-ess.atlas", "../Resource/spineboy-ess.json")) {
@@ -121,6 +127,7 @@ bool SpineRenderer::Initialize(HWND hwnd, int width, int height) {
 void SpineRenderer::Shutdown()
 {
 	ReleaseSpine();
+	m_assetCache.reset(); // 텍스처 로더보다 먼저 해제
 	ReleaseDirect2D();
 }
 
@@ -513,17 +520,24 @@ void SpineRenderer::SetPreviousAnimation() {
 
 bool SpineRenderer::LoadSpine(const std::string& atlasPath, const std::string& jsonPath)
 {
-	m_atlas.reset();
-	m_atlas = std::make_unique<spine::Atlas>(atlasPath.c_str(), m_textureLoader.get());
-	spine::SkeletonJson json(m_atlas.get());
-
-	m_skeletonData.reset(json.readSkeletonDataFile(jsonPath.c_str())); // 내부 new
-	if (!m_skeletonData)
+	// 같은 파일은 캐시에서 공유되므로 Skeleton과 AnimationState만 새로 생성된다.
+	// 기존 리소스를 먼저 해제하면 같은 파일을 다시 불러올 때 캐시에서 삭제된 뒤 다시 로드되므로,
+	// 새 리소스를 먼저 얻고 나서 기존 리소스를 해제한다. 실패하면 기존 상태를 그대로 유지한다.
+	spine::Atlas* atlas = m_assetCache->acquireAtlas(atlasPath.c_str());
+	spine::SkeletonData* skeletonData = atlas ? m_assetCache->acquireSkeletonData(jsonPath.c_str(), atlasPath.c_str()) : nullptr;
+	if (!skeletonData) {
+		std::cout << "Spine load failed: " << m_assetCache->getError().buffer() << std::endl;
+		if (atlas) m_assetCache->releaseAtlas(atlas);
 		return false;
+	}
 
-	m_skeleton.reset(new spine::Skeleton(m_skeletonData.get()));
-	m_stateData.reset(new spine::AnimationStateData(m_skeletonData.get()));
-	m_state.reset(new  spine::AnimationState(m_stateData.get()));
+	ReleaseSpine();
+	m_atlas = atlas;
+	m_skeletonData = skeletonData;
+	m_stateData = m_assetCache->getAnimationStateData(m_skeletonData);
+
+	m_skeleton.reset(new spine::Skeleton(m_skeletonData));
+	m_state.reset(new  spine::AnimationState(m_stateData));
 	// 애니메이션 목록 채우기
 	m_animationList.clear();
 	for (int i = 0; i < m_skeletonData->getAnimations().size(); ++i) {
@@ -536,14 +550,19 @@ void SpineRenderer::ReleaseSpine()
 {
 	// spine-cpp 객체들 해제
 	m_state.reset();
-	m_stateData.reset();
 	m_skeleton.reset();
-	m_skeletonData.reset();
-	m_atlas.reset();
+	m_stateData = nullptr;
+
+	// 캐시 참조 해제. 마지막 참조가 해제되면 비트맵도 해제된다.
+	if (m_assetCache) {
+		if (m_skeletonData)
+			m_assetCache->releaseSkeletonData(m_skeletonData);
+		if (m_atlas)
+			m_assetCache->releaseAtlas(m_atlas);
+	}
+	m_skeletonData = nullptr;
+	m_atlas = nullptr;
 	m_spineBitmap.Reset();
-
-	if(m_textureLoader)
-		m_textureLoader->unload(nullptr); // 비트맵 해제)
 }
 
 void SpineRenderer::ReleaseDirect2D()
@@ -7,6 +7,7 @@
 #include <spine/SkeletonData.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SpineAssetCache.h>
 #include <spine/TextureLoader.h>
 #include <wrl/client.h>
 #include <d2d1_3.h>
@@ -83,10 +84,13 @@ private:
     // Spine-cpp ü
     std::unique_ptr<Direct2DTextureLoader> m_textureLoader;
 
-    std::unique_ptr<spine::Atlas> m_atlas;
-    std::unique_ptr<spine::SkeletonData> m_skeletonData;
+    std::unique_ptr<spine::SpineAssetCache> m_assetCache;
+
+    // m_assetCache ϴ  ҽ
+    spine::Atlas* m_atlas = nullptr;
+    spine::SkeletonData* m_skeletonData = nullptr;
+    spine::AnimationStateData* m_stateData = nullptr;
     std::unique_ptr<spine::Skeleton> m_skeleton;
-    std::unique_ptr<spine::AnimationStateData> m_stateData;
     std::unique_ptr<spine::AnimationState> m_state;
 
     // ִϸ̼   
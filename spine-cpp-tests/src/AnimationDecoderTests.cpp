@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <stdio.h>
+#include <thread>
+
+using namespace spine;
+using namespace spine_tests;
+
+static SkeletonData *readLazy(Atlas *atlas, const std::string &name) {
+	SkeletonJson json(atlas);
+	json.setLazyAnimations(true);
+	SkeletonData *skeletonData = json.readSkeletonDataFile((resourceDirectory() + name + ".json").c_str());
+	CHECK(skeletonData != NULL && skeletonData->getAnimationDecoder() != NULL);
+	return skeletonData;
+}
+
+SPINE_TEST(lazyAnimationsMatchEager) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		std::string json = readFile(resourceDirectory() + name + ".json");
+		Vector<unsigned char> binary;
+		CHECK(readBinary(name, binary));
+
+		SkeletonJson eagerJson(atlas.get()), lazyJson(atlas.get());
+		lazyJson.setLazyAnimations(true);
+		SkeletonBinary eagerBinary(atlas.get()), lazyBinary(atlas.get());
+		lazyBinary.setLazyAnimations(true);
+		SkeletonData *expected = eagerJson.readSkeletonData(json.c_str());
+		SkeletonData *loaded[] = {
+				lazyJson.readSkeletonData(json.c_str()),
+				eagerBinary.readSkeletonData(binary.buffer(), (int) binary.size()),
+				lazyBinary.readSkeletonData(binary.buffer(), (int) binary.size()),
+		};
+		CHECK(expected && loaded[0] && loaded[1] && loaded[2]);
+		if (expected && loaded[0] && loaded[1] && loaded[2]) {
+			/* Lazy loads must match the eager load of the same format, and play back like the JSON. */
+			CHECK(firstDifference(dumpSkeletonData(expected), dumpSkeletonData(loaded[0])).empty());
+			CHECK(firstDifference(dumpSkeletonData(loaded[1]), dumpSkeletonData(loaded[2])).empty());
+			uint64_t expectedHash = hashPlayback(expected, 10);
+			for (int ii = 0; ii < 3; ii++)
+				CHECK(hashPlayback(loaded[ii], 10) == expectedHash);
+		}
+		for (int ii = 0; ii < 3; ii++)
+			delete loaded[ii];
+		delete expected;
+	}
+}
+
+SPINE_TEST(lazyAnimationsKeepOnlyTheirText) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		std::string json = readFile(resourceDirectory() + name + ".json");
+		SpineExtension *extension = SpineExtension::getInstance();
+
+		/* Eager, lazy, then lazy and streaming. Lazy loads must not keep the parsed document. */
+		size_t liveBytes[3];
+		for (int mode = 0; mode < 3; mode++) {
+			AllocationProfiler profiler(extension);
+			SpineExtension::setInstance(&profiler);
+			SkeletonJson loader(atlas.get());
+			loader.setLazyAnimations(mode > 0);
+			loader.setStreaming(mode == 2);
+			SkeletonData *skeletonData = loader.readSkeletonData(json.c_str());
+			liveBytes[mode] = profiler.getTotals().liveBytes;
+			delete skeletonData;
+			SpineExtension::setInstance(extension);
+			CHECK(skeletonData != NULL);
+		}
+		CHECK(liveBytes[1] == liveBytes[2]);
+		CHECK(liveBytes[1] < liveBytes[0] + json.size());
+	}
+}
+
+SPINE_TEST(acquireFailsWithoutReference) {
+	TestAtlas atlas("spineboy");
+	SkeletonJson json(atlas.get());
+	json.setLazyAnimations(true);
+	SkeletonData *skeletonData = json.readSkeletonData(
+			"{\"bones\":[{\"name\":\"root\"}],\"animations\":{\"a\":{\"slots\":{\"nope\":{}}}}}");
+	CHECK(skeletonData != NULL);
+	if (!skeletonData) return;
+	AnimationDecoder *decoder = skeletonData->getAnimationDecoder();
+	Animation *animation = skeletonData->getAnimations()[0];
+	CHECK(!decoder->acquire(animation));
+	CHECK(!decoder->getError().isEmpty());
+	CHECK(!animation->isLoaded());
+	CHECK(skeletonData->findAnimation("a") == NULL);
+	delete skeletonData;
+}
+
+SPINE_TEST(evictionIsOptIn) {
+	TestAtlas atlas("spineboy");
+	SkeletonData *skeletonData = readLazy(atlas.get(), "spineboy");
+	if (!skeletonData) return;
+	AnimationDecoder *decoder = skeletonData->getAnimationDecoder();
+
+	/* Animations found by name stay loaded. */
+	Animation *walk = skeletonData->findAnimation("walk");
+	CHECK(walk != NULL && walk->isLoaded());
+	decoder->evict(0);
+	CHECK(walk->isLoaded());
+
+	/* Acquired animations stay loaded until released. */
+	Animation *run = skeletonData->findAnimation("run");
+	decoder->unload(run);
+	CHECK(!run->isLoaded());
+	CHECK(decoder->acquire(run));
+	CHECK(decoder->acquire(run));
+	decoder->evict(0);
+	CHECK(run->isLoaded());
+	decoder->release(run);
+	decoder->evict(0);
+	CHECK(run->isLoaded());
+	decoder->release(run);
+	decoder->evict(0);
+	CHECK(!run->isLoaded());
+	CHECK(walk->isLoaded());
+
+	/* Loading it without acquiring keeps it, also after a later acquire and release. */
+	CHECK(skeletonData->loadAnimation(run));
+	decoder->evict(0);
+	CHECK(run->isLoaded());
+	CHECK(decoder->acquire(run));
+	decoder->release(run);
+	decoder->evict(0);
+	CHECK(run->isLoaded());
+
+	/* The budget evicts released animations when others are decoded. */
+	Animation *jump = skeletonData->findAnimation("jump");
+	decoder->unload(jump);
+	decoder->unload(run);
+	CHECK(decoder->acquire(run));
+	decoder->release(run);
+	decoder->setMemoryBudget(1);
+	CHECK(decoder->acquire(jump));
+	CHECK(jump->isLoaded());
+	CHECK(!run->isLoaded());
+	CHECK(walk->isLoaded());
+	decoder->release(jump);
+	delete skeletonData;
+}
+
+SPINE_TEST(playingAnimationSurvivesAcquireAndRelease) {
+	TestAtlas atlas("spineboy");
+	SkeletonData *skeletonData = readLazy(atlas.get(), "spineboy");
+	if (!skeletonData) return;
+	AnimationDecoder *decoder = skeletonData->getAnimationDecoder();
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	AnimationState state(&stateData);
+
+	/* The track entry loaded the animation without acquiring it, so another user's release must not evict it. */
+	Animation *walk = state.setAnimation(0, "walk", true)->getAnimation();
+	CHECK(decoder->acquire(walk));
+	decoder->release(walk);
+	decoder->evict(0);
+	CHECK(walk->isLoaded());
+	decoder->setMemoryBudget(1);
+	CHECK(decoder->acquire(skeletonData->getAnimations()[0]));
+	decoder->release(skeletonData->getAnimations()[0]);
+	CHECK(walk->isLoaded());
+	for (int frame = 0; frame < 10; frame++) {
+		state.update(1 / 30.0f);
+		state.apply(skeleton);
+	}
+	state.clearTracks();
+	delete skeletonData;
+}
+
+SPINE_TEST(animationStateMayOutliveLazySkeletonData) {
+	TestAtlas atlas("spineboy");
+	SkeletonData *skeletonData = readLazy(atlas.get(), "spineboy");
+	if (!skeletonData) return;
+	AnimationStateData *stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+	AnimationState *state = new (__FILE__, __LINE__) AnimationState(stateData);
+	Skeleton *skeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	state->setAnimation(0, "walk", true);
+	state->addAnimation(0, "run", true, 0);
+	state->update(0.5f);
+	state->apply(*skeleton);
+	delete skeleton;
+	delete skeletonData;
+	delete state;
+	delete stateData;
+}
+
+SPINE_TEST(acquiredAnimationsSurviveConcurrentEviction) {
+	TestAtlas atlas("spineboy");
+	SkeletonData *skeletonData = readLazy(atlas.get(), "spineboy");
+	if (!skeletonData) return;
+	AnimationDecoder *decoder = skeletonData->getAnimationDecoder();
+	decoder->setMemoryBudget(1);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	bool loaded[4] = {true, true, true, true};
+	std::thread threads[4];
+	for (int t = 0; t < 4; t++) {
+		threads[t] = std::thread([&, t]() {
+			for (int i = 0; i < 200; i++) {
+				Animation *animation = animations[(i * 7 + t) % animations.size()];
+				if (!decoder->acquire(animation)) {
+					loaded[t] = false;
+					continue;
+				}
+				loaded[t] = loaded[t] && animation->isLoaded() && animation->getTimelines().size() > 0;
+				decoder->release(animation);
+			}
+		});
+	}
+	for (int t = 0; t < 4; t++) threads[t].join();
+	CHECK(loaded[0] && loaded[1] && loaded[2] && loaded[3]);
+	decoder->evict(0);
+	CHECK(decoder->getMemoryUsed() == 0);
+	delete skeletonData;
+}
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <thread>
+
+using namespace spine;
+using namespace spine_tests;
+
+/* Loads the JSON with and without streaming and the binary export. */
+static void readAll(Atlas *atlas, const std::string &json, Vector<unsigned char> &binary, bool useArena,
+					SkeletonData *loaded[3]) {
+	SkeletonJson dom(atlas), streaming(atlas);
+	dom.setUseArena(useArena);
+	streaming.setUseArena(useArena);
+	streaming.setStreaming(true);
+	SkeletonBinary skeletonBinary(atlas);
+	skeletonBinary.setUseArena(useArena);
+	loaded[0] = dom.readSkeletonData(json.c_str());
+	loaded[1] = streaming.readSkeletonData(json.c_str());
+	loaded[2] = skeletonBinary.readSkeletonData(binary.buffer(), (int) binary.size());
+}
+
+/* Counts the allocations that are still live after the test function returns. */
+static size_t leakedAllocations(void (*function)(const std::string &name), const std::string &name) {
+	SpineExtension *extension = SpineExtension::getInstance();
+	AllocationProfiler *profiler = new AllocationProfiler(extension);
+	SpineExtension::setInstance(profiler);
+	function(name);
+	SpineExtension::setInstance(extension);
+	size_t live = profiler->getTotals().liveAllocations;
+	delete profiler;
+	return live;
+}
+
+SPINE_TEST(arenaLoadsMatchHeapLoads) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		std::string json = readFile(resourceDirectory() + name + ".json");
+		Vector<unsigned char> binary;
+		CHECK(readBinary(name, binary));
+
+		SkeletonData *expected[3], *actual[3];
+		readAll(atlas.get(), json, binary, false, expected);
+		readAll(atlas.get(), json, binary, true, actual);
+		for (int ii = 0; ii < 3; ii++) {
+			CHECK(expected[ii] && actual[ii]);
+			if (!expected[ii] || !actual[ii]) continue;
+			CHECK(actual[ii]->getArena().getUsed() > 0);
+			CHECK(firstDifference(dumpSkeletonData(expected[ii]), dumpSkeletonData(actual[ii])).empty());
+			CHECK(hashPlayback(expected[ii], 10) == hashPlayback(actual[ii], 10));
+		}
+		for (int ii = 0; ii < 3; ii++) {
+			delete expected[ii];
+			delete actual[ii];
+		}
+	}
+}
+
+static void loadArenaSkeletonData(const std::string &name) {
+	TestAtlas atlas(name);
+	std::string json = readFile(resourceDirectory() + name + ".json");
+	Vector<unsigned char> binary;
+	CHECK(readBinary(name, binary));
+	SkeletonData *loaded[3];
+	readAll(atlas.get(), json, binary, true, loaded);
+	for (int i = 0; i < 3; i++) {
+		CHECK(loaded[i] != NULL);
+		if (!loaded[i]) continue;
+		/* Memory moved out of the arena and objects added after loading are freed with the skeleton data. */
+		loaded[i]->getEvents().add(new (__FILE__, __LINE__) EventData("added"));
+		loaded[i]->getAnimations().ensureCapacity(loaded[i]->getAnimations().size() * 4 + 16);
+		hashPlayback(loaded[i], 5);
+		delete loaded[i];
+	}
+}
+
+SPINE_TEST(arenaSkeletonDataFreesEverything) {
+	/* The atoms of names are released by the destructors, so nothing outlives the skeleton data. */
+	for (size_t i = 0; i < skeletonNames().size(); i++)
+		CHECK(leakedAllocations(loadArenaSkeletonData, skeletonNames()[i]) == 0);
+}
+
+static void failArenaLoads(const std::string &name) {
+	TestAtlas atlas(name);
+	std::string json = readFile(resourceDirectory() + name + ".json");
+	Vector<unsigned char> binary;
+	CHECK(readBinary(name, binary));
+	/* The loader's locals in the arena are gone before the skeleton data and its arena are deleted. The JSON fails
+	 * after everything but the animations was read, the binary on its version. */
+	size_t animations = json.find("\"animations\"");
+	CHECK(animations != std::string::npos);
+	if (animations == std::string::npos) return;
+	json.insert(json.find('{', animations) + 1, "\"broken\": { \"bones\": { \"missing\": { \"rotate\": [ {} ] } } },");
+	binary[9] = '0';
+	SkeletonData *loaded[3];
+	readAll(atlas.get(), json, binary, true, loaded);
+	for (int i = 0; i < 3; i++) {
+		CHECK(loaded[i] == NULL);
+		delete loaded[i];
+	}
+}
+
+SPINE_TEST(failedArenaLoadsReleaseTheArena) {
+	for (size_t i = 0; i < skeletonNames().size(); i++)
+		CHECK(leakedAllocations(failArenaLoads, skeletonNames()[i]) == 0);
+}
+
+SPINE_TEST(arenaMemoryIsFreedConcurrently) {
+	/* Chunks are added and removed while other threads free arena and heap memory. */
+	std::string json = readFile(resourceDirectory() + "spineboy.json");
+	TestAtlas atlas("spineboy");
+	bool loaded[4] = {true, true, true, true};
+	std::thread threads[4];
+	for (int t = 0; t < 4; t++) {
+		threads[t] = std::thread([&, t]() {
+			SkeletonJson skeletonJson(atlas.get());
+			skeletonJson.setUseArena(true);
+			for (int i = 0; i < 8; i++) {
+				SkeletonData *skeletonData = skeletonJson.readSkeletonData(json.c_str());
+				if (!skeletonData) {
+					loaded[t] = false;
+					continue;
+				}
+				hashPlayback(skeletonData, 2);
+				delete skeletonData;
+			}
+		});
+	}
+	for (int t = 0; t < 4; t++) threads[t].join();
+	for (int t = 0; t < 4; t++) CHECK(loaded[t]);
+}
+
+/* Fills new memory, so bytes a reallocation copied can be told from those it didn't. */
+class FillingExtension : public DefaultSpineExtension {
+protected:
+	virtual void *_alloc(size_t size, const char *file, int line) override {
+		void *ptr = DefaultSpineExtension::_alloc(size, file, line);
+		memset(ptr, 'x', size);
+		return ptr;
+	}
+};
+
+SPINE_TEST(arenaReallocationCopiesTheOldSize) {
+	SpineExtension *extension = SpineExtension::getInstance();
+	FillingExtension filling;
+	SpineExtension::setInstance(&filling);
+	DataArena *arena = new (__FILE__, __LINE__) DataArena();
+	char *first, *second;
+	{
+		DataArena::Scope scope(arena);
+		first = SpineExtension::alloc<char>(24, __FILE__, __LINE__);
+		second = SpineExtension::alloc<char>(40, __FILE__, __LINE__);
+		memset(first, 'a', 24);
+		memset(second, 'b', 40);
+		/* The most recent allocation grows in place. */
+		CHECK(SpineExtension::realloc(second, 100, __FILE__, __LINE__) == second);
+	}
+	/* Without a scope, reallocating moves arena memory to the heap. Only the old size is copied, not the memory
+	 * after it. */
+	char *moved = SpineExtension::realloc(first, 200, __FILE__, __LINE__);
+	CHECK(moved != first);
+	for (int i = 0; i < 200; i++) CHECK(moved[i] == (i < 24 ? 'a' : 'x'));
+	SpineExtension::free(moved, __FILE__, __LINE__);
+	SpineExtension::free(second, __FILE__, __LINE__);
+
+	/* Threads sharing an arena reallocate while the others allocate right after their memory. */
+	bool copied[4] = {true, true, true, true};
+	std::thread threads[4];
+	for (int t = 0; t < 4; t++) {
+		threads[t] = std::thread([&, t]() {
+			DataArena::Scope scope(arena);
+			for (int i = 0; i < 1000; i++) {
+				char *grown = SpineExtension::alloc<char>(16, __FILE__, __LINE__);
+				memset(grown, 'a' + t, 16);
+				char *next = SpineExtension::alloc<char>(16, __FILE__, __LINE__);
+				memset(next, 'a' + t, 16);
+				std::this_thread::yield();
+				grown = SpineExtension::realloc(grown, 64, __FILE__, __LINE__);
+				for (int ii = 0; ii < 16; ii++) copied[t] = copied[t] && grown[ii] == 'a' + t;
+				SpineExtension::free(next, __FILE__, __LINE__);
+				SpineExtension::free(grown, __FILE__, __LINE__);
+			}
+		});
+	}
+	for (int t = 0; t < 4; t++) threads[t].join();
+	for (int t = 0; t < 4; t++) CHECK(copied[t]);
+	delete arena;
+	SpineExtension::setInstance(extension);
+}
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <stdio.h>
+
+using namespace spine;
+using namespace spine_tests;
+
+/* Plays every animation with a queued animation on a second track, so entries are mixed, pooled and reused. */
+static void play(SkeletonData *skeletonData, Skeleton &skeleton, AnimationState &state, SkeletonRenderer &renderer,
+				 FrameArena *arena) {
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++) {
+		state.setAnimation(0, animations[i], true);
+		if (animations.size() > 1) state.addAnimation(1, animations[(i + 1) % animations.size()], false, 0);
+		for (int frame = 0; frame < 60; frame++) {
+			state.update(1 / 30.0f);
+			state.apply(skeleton);
+			skeleton.update(1 / 30.0f);
+			skeleton.updateWorldTransform(Physics_Update);
+			renderer.render(skeleton);
+			if (arena) arena->reset();
+		}
+	}
+}
+
+/* Counts the allocations of a playback after two warm up playbacks. The first fills the pools and sizes the buffers
+ * the instances keep. The second reaches the high water mark of buffers sized by the mix, which depends on the entries
+ * still queued from the previous playback. */
+static size_t steadyAllocations(SkeletonData *skeletonData, FrameArena *arena) {
+	Skeleton skeleton(skeletonData);
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+	AnimationState state(&stateData);
+	SkeletonRenderer renderer;
+	renderer.setUseFrameArena(arena != NULL);
+
+	play(skeletonData, skeleton, state, renderer, arena);
+	play(skeletonData, skeleton, state, renderer, arena);
+	SpineExtension *extension = SpineExtension::getInstance();
+	AllocationProfiler *profiler = new AllocationProfiler(extension);
+	SpineExtension::setInstance(profiler);
+	play(skeletonData, skeleton, state, renderer, arena);
+	SpineExtension::setInstance(extension);
+	AllocationProfiler::Totals totals = profiler->getTotals();
+	delete profiler;
+	state.clearTracks();
+	return totals.allocations + totals.reallocations;
+}
+
+static void checkSteadyPlayback(bool useFrameArena) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		SkeletonJson json(atlas.get());
+		SkeletonData *skeletonData = json.readSkeletonDataFile((resourceDirectory() + name + ".json").c_str());
+		CHECK(skeletonData != NULL);
+		if (!skeletonData) continue;
+
+		size_t allocations;
+		if (useFrameArena) {
+			FrameArena arena;
+			FrameArena::Scope scope(arena);
+			allocations = steadyAllocations(skeletonData, &arena);
+		} else
+			allocations = steadyAllocations(skeletonData, NULL);
+		if (allocations) printf("  %s: %d allocations\n", name.c_str(), (int) allocations);
+		CHECK(allocations == 0);
+		delete skeletonData;
+	}
+}
+
+SPINE_TEST(steadyPlaybackDoesNotAllocate) {
+	checkSteadyPlayback(false);
+}
+
+SPINE_TEST(steadyPlaybackWithFrameArenaDoesNotAllocate) {
+	checkSteadyPlayback(true);
+}
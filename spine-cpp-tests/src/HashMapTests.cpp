@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+using namespace spine;
+using namespace spine_tests;
+
+SPINE_TEST(hashMapKeysFoldHighBits) {
+	/* The hash must depend on the high half of 64-bit keys even where size_t is 32 bits. */
+	long long low = 5, high = low | (1LL << 40);
+	CHECK((uint32_t) HashMapKey<long long>::hashCode(low) != (uint32_t) HashMapKey<long long>::hashCode(high));
+	double one = 1, two = 2;
+	CHECK((uint32_t) HashMapKey<double>::hashCode(one) != (uint32_t) HashMapKey<double>::hashCode(two));
+	CHECK((uint32_t) HashMapKey<String>::hashCode(String("a")) != (uint32_t) HashMapKey<String>::hashCode(String("b")));
+}
+
+SPINE_TEST(hashMapStoresKeysDifferingInHighBits) {
+	HashMap<PropertyId, int> map;
+	for (int i = 0; i < 1000; i++) map.put(((PropertyId) i << 32) | 7, i);
+	CHECK(map.size() == 1000);
+	bool found = true;
+	for (int i = 0; i < 1000; i++) found &= map.containsKey(((PropertyId) i << 32) | 7) && map[((PropertyId) i << 32) | 7] == i;
+	CHECK(found);
+	CHECK(!map.containsKey(7 | (1000LL << 32)));
+	for (int i = 0; i < 1000; i += 2) map.remove(((PropertyId) i << 32) | 7);
+	CHECK(map.size() == 500);
+	found = true;
+	for (int i = 0; i < 1000; i++) found &= map.containsKey(((PropertyId) i << 32) | 7) == (i % 2 == 1);
+	CHECK(found);
+}
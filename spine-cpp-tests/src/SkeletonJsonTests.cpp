@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace spine;
+using namespace spine_tests;
+
+/* Loads the skeleton with the DOM reader and with the given options and checks the results are identical. */
+static void checkSameAsDom(const std::string &json, Atlas *atlas, bool lazy, int threads) {
+	SkeletonJson dom(atlas);
+	SkeletonData *expected = dom.readSkeletonData(json.c_str());
+	CHECK(expected != NULL);
+
+	SkeletonJson streaming(atlas);
+	streaming.setStreaming(true);
+	streaming.setLazyAnimations(lazy);
+	streaming.setThreadCount(threads);
+	SkeletonData *actual = streaming.readSkeletonData(json.c_str());
+	CHECK(actual != NULL);
+	if (!actual) printf("  error: %s\n", streaming.getError().buffer());
+
+	if (expected && actual) {
+		std::string difference = firstDifference(dumpSkeletonData(expected), dumpSkeletonData(actual));
+		CHECK(difference.empty());
+		if (!difference.empty()) printf("  %s\n", difference.c_str());
+		CHECK(hashPlayback(expected, 10) == hashPlayback(actual, 10));
+	}
+	delete actual;
+	delete expected;
+}
+
+SPINE_TEST(streamingMatchesDom) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		std::string json = readFile(resourceDirectory() + name + ".json");
+		CHECK(!json.empty());
+		TestAtlas atlas(name);
+		checkSameAsDom(json, atlas.get(), false, 0);
+	}
+}
+
+SPINE_TEST(streamingLazyMatchesDom) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		checkSameAsDom(readFile(resourceDirectory() + name + ".json"), atlas.get(), true, 0);
+	}
+}
+
+SPINE_TEST(streamingParallelMatchesDom) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		checkSameAsDom(readFile(resourceDirectory() + name + ".json"), atlas.get(), false, 4);
+	}
+}
+
+SPINE_TEST(streamingReadsHandWrittenDocuments) {
+	const char *documents[] = {
+			"{\"bones\":[{\"name\":\"root\"}],\"slots\":[{\"name\":\"s\",\"bone\":\"root\"}],\"skins\":[{\"name\":\"default\"}]}",
+			"{\n\t\"skeleton\": {\"spine\": \"4.2.22\"},\n\t\"bones\": [\n\t\t{ \"name\": \"root\" }\n\t],\n\t\"slots\": [\n\t\t{ \"name\": \"s\", \"bone\": \"root\" }\n\t]\n}\n",
+			"{\"slots\":[{\"name\":\"s\",\"bone\":\"root\"}],\"bones\":[{\"name\":\"root\"}]}",
+			"{\"bones\":[{\"name\":\"root\"}],\"events\":{\"e\":{\"int\":3,\"string\":\"x\"}},\"animations\":{\"a\\\"b\":{},\"c\":{\"bones\":{\"root\":{\"rotate\":[{\"value\":90}]}}}}}",
+			"{\"bones\":[{\"name\":\"root\"},{\"name\":\"child\",\"parent\":\"root\",\"x\":1.5}],\"ik\":[{\"name\":\"ik\",\"bones\":[\"child\"],\"target\":\"root\"}]}",
+	};
+	TestAtlas atlas("spineboy");
+	for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+		checkSameAsDom(documents[i], atlas.get(), false, 0);
+		checkSameAsDom(documents[i], atlas.get(), true, 0);
+	}
+}
+
+SPINE_TEST(streamingReportsDomErrors) {
+	const char *documents[] = {
+			"{\"bones\":[{\"name\":\"root\"},{\"name\":\"a\",\"parent\":\"x\"}]}",
+			"{\"skeleton\":{\"spine\":\"3.8\"}}",
+			"{\"animations\":{\"a\":{\"slots\":{\"nope\":{}}}},\"bones\":[{\"name\":\"root\"}]}",
+			"{\"bones\":[{\"name\":\"root\"}],\"slots\":[{\"name\":\"s\",\"bone\":\"nope\"}]}",
+	};
+	TestAtlas atlas("spineboy");
+	for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+		SkeletonJson dom(atlas.get()), streaming(atlas.get());
+		streaming.setStreaming(true);
+		SkeletonData *expected = dom.readSkeletonData(documents[i]);
+		SkeletonData *actual = streaming.readSkeletonData(documents[i]);
+		CHECK(expected == NULL && actual == NULL);
+		CHECK(dom.getError() == streaming.getError());
+		delete expected;
+		delete actual;
+	}
+
+	SkeletonJson streaming(atlas.get());
+	streaming.setStreaming(true);
+	CHECK(streaming.readSkeletonData("{\"bones\":[{\"name\":\"root\"}") == NULL);
+	CHECK(!streaming.getError().isEmpty());
+}
+
+SPINE_TEST(jsonDocumentOutlivesItsText) {
+	std::string text = "{\"a\": 1, \"B\": \"two\", \"c\": 3, \"d\": 4, \"e\": \"t\\u00e9\\\"x\", \"b\": 5, "
+					   "\"f\": {\"g\": \"two\"}}";
+	Json *root = new (__FILE__, __LINE__) Json(text.c_str());
+	/* Strings are kept by the document, not the text. */
+	text.assign(text.size(), ' ');
+	CHECK(Json::getInt(root, "a", 0) == 1);
+	CHECK(Json::getInt(root, "D", 0) == 4);
+	CHECK(strcmp(Json::getString(root, "e", ""), "t\xc3\xa9\"x") == 0);
+	/* Lookups are case insensitive and the first item with a name wins, also in indexed objects. */
+	CHECK(strcmp(Json::getString(root, "b", ""), "two") == 0);
+	CHECK(Json::getItem(root, "missing") == NULL);
+	Json *f = Json::getItem(root, "f");
+	CHECK(f != NULL && strcmp(Json::getString(f, "g", ""), "two") == 0);
+	delete root;
+}
@@ -0,0 +1,86 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <string.h>
+
+using namespace spine;
+using namespace spine_tests;
+
+static bool sameCommand(RenderCommand *expected, RenderCommand *actual) {
+	return expected->numVertices == actual->numVertices && expected->numIndices == actual->numIndices &&
+		   expected->texture == actual->texture && expected->blendMode == actual->blendMode &&
+		   !memcmp(expected->positions, actual->positions, sizeof(float) * 2 * expected->numVertices) &&
+		   !memcmp(expected->uvs, actual->uvs, sizeof(float) * 2 * expected->numVertices) &&
+		   !memcmp(expected->colors, actual->colors, sizeof(uint32_t) * expected->numVertices) &&
+		   !memcmp(expected->indices, actual->indices, sizeof(uint16_t) * expected->numIndices);
+}
+
+SPINE_TEST(staticBufferCommandsAreMerged) {
+	for (size_t i = 0; i < skeletonNames().size(); i++) {
+		const std::string &name = skeletonNames()[i];
+		TestAtlas atlas(name);
+		SkeletonJson json(atlas.get());
+		SkeletonData *skeletonData = json.readSkeletonDataFile((resourceDirectory() + name + ".json").c_str());
+		CHECK(skeletonData != NULL);
+		if (!skeletonData) continue;
+
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		SkeletonRenderer copied, referenced;
+		referenced.setStaticBuffers(true);
+		bool same = true, referencesOwner = true;
+		for (size_t ii = 0; ii < skeletonData->getAnimations().size(); ii++) {
+			state.setAnimation(0, skeletonData->getAnimations()[ii], true);
+			for (int frame = 0; frame < 10; frame++) {
+				state.update(1 / 30.0f);
+				state.apply(skeleton);
+				skeleton.updateWorldTransform(Physics_Update);
+				RenderCommand *expected = copied.render(skeleton), *actual = referenced.render(skeleton);
+				for (; expected && actual; expected = expected->next, actual = actual->next) {
+					same &= sameCommand(expected, actual);
+					if (!actual->buffersOwner) continue;
+					/* A command keeping the reference was not merged, so it draws exactly one attachment. */
+					Attachment *attachment = (Attachment *) actual->buffersOwner;
+					if (attachment->getRTTI().isExactly(RegionAttachment::rtti))
+						referencesOwner &= actual->uvs == ((RegionAttachment *) attachment)->getUVs().buffer();
+					else
+						referencesOwner &= actual->uvs == ((MeshAttachment *) attachment)->getUVs().buffer();
+				}
+				same &= expected == NULL && actual == NULL;
+			}
+		}
+		state.clearTracks();
+		CHECK(same);
+		CHECK(referencesOwner);
+		delete skeletonData;
+	}
+}
@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <stdio.h>
+
+using namespace spine;
+using namespace spine_tests;
+
+namespace {
+	class CountingTextureLoader : public NullTextureLoader {
+	public:
+		int loads;
+
+		CountingTextureLoader() : loads(0) {}
+
+		virtual void load(AtlasPage &page, const String &path) {
+			loads++;
+			NullTextureLoader::load(page, path);
+		}
+	};
+
+	/* A copy of a file in the resource directory, deleted when the test ends. */
+	class TemporaryFile {
+	public:
+		std::string path;
+
+		TemporaryFile(const std::string &name, const std::string &contents) : path(resourceDirectory() + name) {
+			FILE *file = fopen(path.c_str(), "wb");
+			if (file) {
+				fwrite(contents.data(), 1, contents.size(), file);
+				fclose(file);
+			}
+		}
+
+		~TemporaryFile() {
+			remove(path.c_str());
+		}
+	};
+}
+
+SPINE_TEST(assetCacheSharesIdenticalFiles) {
+	CountingTextureLoader textureLoader;
+	SpineAssetCache cache(&textureLoader);
+	std::string atlasPath = resourceDirectory() + "spineboy.atlas", jsonPath = resourceDirectory() + "spineboy.json";
+	std::string json = readFile(jsonPath);
+	TemporaryFile atlasCopy("spine-cpp-tests-copy.atlas", readFile(atlasPath));
+	TemporaryFile jsonCopy("spine-cpp-tests-copy.json", json);
+	TemporaryFile jsonChanged("spine-cpp-tests-changed.json", json + " ");
+
+	Atlas *atlas = cache.acquireAtlas(atlasPath.c_str());
+	Atlas *atlasAlias = cache.acquireAtlas(atlasCopy.path.c_str());
+	CHECK(atlas != NULL && atlas == atlasAlias);
+	CHECK(cache.getAtlasCount() == 1);
+	int loads = textureLoader.loads;
+
+	SkeletonData *skeletonData = cache.acquireSkeletonData(jsonPath.c_str(), atlasPath.c_str());
+	SkeletonData *skeletonDataAlias = cache.acquireSkeletonData(jsonCopy.path.c_str(), atlasCopy.path.c_str());
+	SkeletonData *changed = cache.acquireSkeletonData(jsonChanged.path.c_str(), atlasPath.c_str());
+	CHECK(skeletonData != NULL && skeletonData == skeletonDataAlias);
+	CHECK(changed != NULL && changed != skeletonData);
+	CHECK(cache.getSkeletonDataCount() == 2);
+	CHECK(textureLoader.loads == loads);
+
+	cache.releaseSkeletonData(changed);
+	cache.releaseSkeletonData(skeletonDataAlias);
+	cache.releaseSkeletonData(skeletonData);
+	cache.releaseAtlas(atlasAlias);
+	cache.releaseAtlas(atlas);
+	CHECK(cache.getSkeletonDataCount() == 0);
+	CHECK(cache.getAtlasCount() == 0);
+}
+
+SPINE_TEST(assetCacheReloadKeepsInstance) {
+	CountingTextureLoader textureLoader;
+	SpineAssetCache cache(&textureLoader);
+	std::string atlasPath = resourceDirectory() + "spineboy-ess.atlas";
+	std::string jsonPath = resourceDirectory() + "spineboy-ess.json";
+
+	/* Loading the same skeleton again acquires the new reference before releasing the old one. */
+	SkeletonData *first = cache.acquireSkeletonData(jsonPath.c_str(), atlasPath.c_str());
+	int loads = textureLoader.loads;
+	SkeletonData *second = cache.acquireSkeletonData(jsonPath.c_str(), atlasPath.c_str());
+	cache.releaseSkeletonData(first);
+	CHECK(first != NULL && first == second);
+	CHECK(textureLoader.loads == loads);
+	CHECK(cache.getAnimationStateData(second) != NULL);
+	cache.releaseSkeletonData(second);
+	CHECK(cache.getSkeletonDataCount() == 0);
+
+	CHECK(cache.acquireSkeletonData((resourceDirectory() + "missing.json").c_str(), atlasPath.c_str()) == NULL);
+	CHECK(!cache.getError().isEmpty());
+	CHECK(cache.getAtlasCount() == 0);
+}
@@ -0,0 +1,408 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include "TestSuite.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace spine;
+
+namespace spine_tests {
+	struct Test {
+		const char *name;
+		TestFunction function;
+	};
+
+	static std::vector<Test> &tests() {
+		static std::vector<Test> tests;
+		return tests;
+	}
+
+	static int failures = 0;
+
+	TestRegistration::TestRegistration(const char *name, TestFunction function) {
+		Test test = {name, function};
+		tests().push_back(test);
+	}
+
+	int runTests(const char *filter) {
+		int run = 0;
+		for (size_t i = 0; i < tests().size(); i++) {
+			Test &test = tests()[i];
+			if (filter && !strstr(test.name, filter)) continue;
+			int failuresBefore = failures;
+			test.function();
+			printf("%s %s\n", failures == failuresBefore ? "[  OK  ]" : "[ FAIL ]", test.name);
+			fflush(stdout);
+			run++;
+		}
+		printf("%d tests, %d failed checks\n", run, failures);
+		return failures;
+	}
+
+	void check(bool condition, const char *expression, const char *file, int line) {
+		if (condition) return;
+		failures++;
+		printf("%s:%d: check failed: %s\n", file, line, expression);
+	}
+
+	std::string &resourceDirectory() {
+		static std::string directory = "../Resource/";
+		return directory;
+	}
+
+	const std::vector<std::string> &skeletonNames() {
+		static std::vector<std::string> names;
+		if (names.empty()) {
+			names.push_back("spineboy");
+			names.push_back("spineboy-ess");
+			names.push_back("alien-ess");
+			names.push_back("hero-ess");
+			names.push_back("speedy-ess");
+		}
+		return names;
+	}
+
+	std::string readFile(const std::string &path) {
+		std::string text;
+		FILE *file = fopen(path.c_str(), "rb");
+		if (!file) return text;
+		char buffer[4096];
+		size_t read;
+		while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+			text.append(buffer, read);
+		fclose(file);
+		return text;
+	}
+
+	void NullTextureLoader::load(AtlasPage &page, const String &path) {
+		SP_UNUSED(path);
+		page.texture = (void *) (size_t) (++_pages * 16);
+		page.width = 1024;
+		page.height = 1024;
+	}
+
+	void NullTextureLoader::unload(void *texture) {
+		SP_UNUSED(texture);
+	}
+
+	TestAtlas::TestAtlas(const std::string &name) {
+		std::string path = resourceDirectory() + name + ".atlas";
+		_atlas = new (__FILE__, __LINE__) Atlas(path.c_str(), &_textureLoader);
+	}
+
+	TestAtlas::~TestAtlas() {
+		delete _atlas;
+	}
+
+	class Dump {
+	public:
+		std::string text;
+
+		Dump &operator<<(const char *value) {
+			text += value ? value : "(null)";
+			return *this;
+		}
+
+		Dump &operator<<(const String &value) {
+			text += "\"";
+			if (value.buffer()) text.append(value.buffer(), value.length());
+			text += "\"";
+			return *this;
+		}
+
+		Dump &operator<<(float value) {
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), " %.9g", value);
+			text += buffer;
+			return *this;
+		}
+
+		Dump &operator<<(long long value) {
+			char buffer[32];
+			snprintf(buffer, sizeof(buffer), " %lld", value);
+			text += buffer;
+			return *this;
+		}
+
+		Dump &operator<<(int value) {
+			return *this << (long long) value;
+		}
+
+		Dump &operator<<(size_t value) {
+			return *this << (long long) value;
+		}
+
+		Dump &operator<<(bool value) {
+			text += value ? " true" : " false";
+			return *this;
+		}
+
+		Dump &operator<<(const Color &color) {
+			return *this << color.r << color.g << color.b << color.a;
+		}
+
+		Dump &operator<<(Vector<float> &values) {
+			*this << " [" << values.size();
+			for (size_t i = 0; i < values.size(); i++) *this << values[i];
+			text += " ]";
+			return *this;
+		}
+
+		Dump &operator<<(Vector<int> &values) {
+			*this << " [" << values.size();
+			for (size_t i = 0; i < values.size(); i++) *this << values[i];
+			text += " ]";
+			return *this;
+		}
+
+		Dump &operator<<(Vector<unsigned short> &values) {
+			*this << " [" << values.size();
+			for (size_t i = 0; i < values.size(); i++) *this << (int) values[i];
+			text += " ]";
+			return *this;
+		}
+
+		Dump &operator<<(Vector<BoneData *> &bones) {
+			*this << " [";
+			for (size_t i = 0; i < bones.size(); i++) *this << bones[i]->getIndex();
+			text += " ]";
+			return *this;
+		}
+
+		void attachment(Attachment *attachment) {
+			*this << attachment->getRTTI().getClassName() << " " << attachment->getName();
+			if (attachment->getRTTI().instanceOf(VertexAttachment::rtti)) {
+				VertexAttachment *vertices = static_cast<VertexAttachment *>(attachment);
+				*this << vertices->getBones() << vertices->getVertices() << vertices->getWorldVerticesLength();
+			}
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+				RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+				*this << " " << region->getPath() << region->getX() << region->getY() << region->getRotation()
+					  << region->getScaleX() << region->getScaleY() << region->getWidth() << region->getHeight()
+					  << region->getColor() << region->getOffset() << region->getUVs();
+			} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+				*this << " " << mesh->getPath() << mesh->getHullLength() << mesh->getRegionUVs() << mesh->getUVs()
+					  << mesh->getTriangles() << mesh->getColor() << mesh->getEdges() << mesh->getWidth()
+					  << mesh->getHeight() << (mesh->getParentMesh() != NULL);
+			} else if (attachment->getRTTI().isExactly(PathAttachment::rtti)) {
+				PathAttachment *path = static_cast<PathAttachment *>(attachment);
+				*this << path->getLengths() << path->isClosed() << path->isConstantSpeed();
+			} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+				ClippingAttachment *clipping = static_cast<ClippingAttachment *>(attachment);
+				*this << (clipping->getEndSlot() ? clipping->getEndSlot()->getIndex() : -1);
+			} else if (attachment->getRTTI().isExactly(PointAttachment::rtti)) {
+				PointAttachment *point = static_cast<PointAttachment *>(attachment);
+				*this << point->getX() << point->getY() << point->getRotation();
+			}
+			text += "\n";
+		}
+
+		void timeline(Timeline *timeline) {
+			*this << "  " << timeline->getRTTI().getClassName();
+			Vector<PropertyId> &ids = timeline->getPropertyIds();
+			for (size_t i = 0; i < ids.size(); i++) *this << (long long) ids[i];
+			*this << timeline->getFrames();
+			if (timeline->getRTTI().instanceOf(CurveTimeline::rtti))
+				*this << static_cast<CurveTimeline *>(timeline)->getCurves();
+			if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti)) {
+				AttachmentTimeline *attachments = static_cast<AttachmentTimeline *>(timeline);
+				*this << attachments->getSlotIndex();
+				for (size_t i = 0; i < attachments->getAttachmentNames().size(); i++)
+					*this << " " << attachments->getAttachmentNames()[i];
+			} else if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+				DeformTimeline *deform = static_cast<DeformTimeline *>(timeline);
+				*this << deform->getSlotIndex() << " " << deform->getAttachment()->getName();
+				for (size_t i = 0; i < deform->getVertices().size(); i++) *this << deform->getVertices()[i];
+			} else if (timeline->getRTTI().isExactly(EventTimeline::rtti)) {
+				Vector<Event *> &events = static_cast<EventTimeline *>(timeline)->getEvents();
+				for (size_t i = 0; i < events.size(); i++) {
+					Event *event = events[i];
+					*this << " " << event->getData().getName() << event->getTime() << event->getIntValue()
+						  << event->getFloatValue() << " " << event->getStringValue() << event->getVolume()
+						  << event->getBalance();
+				}
+			} else if (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti)) {
+				Vector<Vector<int> > &drawOrders = static_cast<DrawOrderTimeline *>(timeline)->getDrawOrders();
+				for (size_t i = 0; i < drawOrders.size(); i++) *this << drawOrders[i];
+			}
+			text += "\n";
+		}
+	};
+
+	std::string dumpSkeletonData(SkeletonData *data) {
+		Dump dump;
+		dump << "skeleton " << data->getName() << " " << data->getVersion() << " " << data->getHash() << data->getX()
+			 << data->getY() << data->getWidth() << data->getHeight() << data->getReferenceScale() << data->getFps()
+			 << " " << data->getImagesPath() << " " << data->getAudioPath() << "\n";
+		for (size_t i = 0; i < data->getBones().size(); i++) {
+			BoneData *bone = data->getBones()[i];
+			dump << "bone " << bone->getName() << bone->getIndex()
+				 << (bone->getParent() ? bone->getParent()->getIndex() : -1) << bone->getLength() << bone->getX()
+				 << bone->getY() << bone->getRotation() << bone->getScaleX() << bone->getScaleY() << bone->getShearX()
+				 << bone->getShearY() << (int) bone->getInherit() << bone->isSkinRequired() << bone->getColor()
+				 << "\n";
+		}
+		for (size_t i = 0; i < data->getSlots().size(); i++) {
+			SlotData *slot = data->getSlots()[i];
+			dump << "slot " << slot->getName() << slot->getIndex() << slot->getBoneData().getIndex()
+				 << slot->getColor() << slot->getDarkColor() << slot->hasDarkColor() << " "
+				 << slot->getAttachmentName() << (int) slot->getBlendMode() << "\n";
+		}
+		for (size_t i = 0; i < data->getIkConstraints().size(); i++) {
+			IkConstraintData *ik = data->getIkConstraints()[i];
+			dump << "ik " << ik->getName() << ik->getOrder() << ik->isSkinRequired() << ik->getBones()
+				 << ik->getTarget()->getIndex() << ik->getBendDirection() << ik->getCompress() << ik->getStretch()
+				 << ik->getUniform() << ik->getMix() << ik->getSoftness() << "\n";
+		}
+		for (size_t i = 0; i < data->getTransformConstraints().size(); i++) {
+			TransformConstraintData *transform = data->getTransformConstraints()[i];
+			dump << "transform " << transform->getName() << transform->getOrder() << transform->isSkinRequired()
+				 << transform->getBones() << transform->getTarget()->getIndex() << transform->getMixRotate()
+				 << transform->getMixX() << transform->getMixY() << transform->getMixScaleX()
+				 << transform->getMixScaleY() << transform->getMixShearY() << transform->getOffsetRotation()
+				 << transform->getOffsetX() << transform->getOffsetY() << transform->getOffsetScaleX()
+				 << transform->getOffsetScaleY() << transform->getOffsetShearY() << transform->isRelative()
+				 << transform->isLocal() << "\n";
+		}
+		for (size_t i = 0; i < data->getPathConstraints().size(); i++) {
+			PathConstraintData *path = data->getPathConstraints()[i];
+			dump << "path " << path->getName() << path->getOrder() << path->isSkinRequired() << path->getBones()
+				 << path->getTarget()->getIndex() << (int) path->getPositionMode() << (int) path->getSpacingMode()
+				 << (int) path->getRotateMode() << path->getOffsetRotation() << path->getPosition()
+				 << path->getSpacing() << path->getMixRotate() << path->getMixX() << path->getMixY() << "\n";
+		}
+		for (size_t i = 0; i < data->getPhysicsConstraints().size(); i++) {
+			PhysicsConstraintData *physics = data->getPhysicsConstraints()[i];
+			dump << "physics " << physics->getName() << physics->getOrder() << physics->isSkinRequired()
+				 << physics->getBone()->getIndex() << physics->getX() << physics->getY() << physics->getRotate()
+				 << physics->getScaleX() << physics->getShearX() << physics->getLimit() << physics->getStep()
+				 << physics->getInertia() << physics->getStrength() << physics->getDamping()
+				 << physics->getMassInverse() << physics->getWind() << physics->getGravity() << physics->getMix()
+				 << "\n";
+		}
+		for (size_t i = 0; i < data->getSkins().size(); i++) {
+			Skin *skin = data->getSkins()[i];
+			dump << "skin " << skin->getName() << (skin == data->getDefaultSkin()) << skin->getBones() << " ["
+				 << skin->getConstraints().size() << " ]\n";
+			Skin::AttachmentMap::Entries entries = skin->getAttachments();
+			while (entries.hasNext()) {
+				Skin::AttachmentMap::Entry &entry = entries.next();
+				dump << " attachment" << entry._slotIndex << " " << entry._name << " ";
+				dump.attachment(entry._attachment);
+			}
+		}
+		for (size_t i = 0; i < data->getEvents().size(); i++) {
+			EventData *event = data->getEvents()[i];
+			dump << "event " << event->getName() << event->getIntValue() << event->getFloatValue() << " "
+				 << event->getStringValue() << " " << event->getAudioPath() << event->getVolume()
+				 << event->getBalance() << "\n";
+		}
+		for (size_t i = 0; i < data->getAnimations().size(); i++) {
+			Animation *animation = data->getAnimations()[i];
+			bool loaded = data->loadAnimation(animation);
+			dump << "animation " << animation->getName() << loaded << animation->getDuration() << "\n";
+			for (size_t ii = 0; ii < animation->getTimelines().size(); ii++)
+				dump.timeline(animation->getTimelines()[ii]);
+		}
+		return dump.text;
+	}
+
+	std::string firstDifference(const std::string &expected, const std::string &actual) {
+		if (expected == actual) return std::string();
+		size_t start = 0, line = 1;
+		while (start < expected.size() && start < actual.size()) {
+			size_t end = expected.find('\n', start);
+			if (end == std::string::npos) end = expected.size();
+			if (expected.compare(start, end - start, actual, start, end - start) != 0 ||
+				(end < actual.size() && actual[end] != '\n'))
+				break;
+			start = end + 1;
+			line++;
+		}
+		char prefix[32];
+		snprintf(prefix, sizeof(prefix), "line %d: ", (int) line);
+		size_t expectedEnd = expected.find('\n', start), actualEnd = actual.find('\n', start);
+		std::string expectedLine = start < expected.size() ? expected.substr(start, expectedEnd - start) : "(end)";
+		std::string actualLine = start < actual.size() ? actual.substr(start, actualEnd - start) : "(end)";
+		return prefix + expectedLine.substr(0, 200) + "\n  actual: " + actualLine.substr(0, 200);
+	}
+
+	static void mix(uint64_t &hash, const void *data, size_t length) {
+		const unsigned char *bytes = (const unsigned char *) data;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	static void mix(uint64_t &hash, const float *values, int count) {
+		for (int i = 0; i < count; i++) {
+			int value = (int) (values[i] * 16);
+			mix(hash, &value, sizeof(value));
+		}
+	}
+
+	uint64_t hashPlayback(SkeletonData *skeletonData, int frames) {
+		uint64_t hash = 1469598103934665603ULL;
+		SkeletonRenderer renderer;
+		Skeleton skeleton(skeletonData);
+		AnimationStateData stateData(skeletonData);
+		AnimationState state(&stateData);
+		for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+			state.setAnimation(0, skeletonData->getAnimations()[i], true);
+			for (int frame = 0; frame < frames; frame++) {
+				state.update(1 / 30.0f);
+				state.apply(skeleton);
+				skeleton.update(1 / 30.0f);
+				skeleton.updateWorldTransform(Physics_Update);
+				for (RenderCommand *command = renderer.render(skeleton); command; command = command->next) {
+					mix(hash, command->positions, command->numVertices * 2);
+					mix(hash, command->uvs, command->numVertices * 2);
+					mix(hash, command->colors, command->numVertices * sizeof(uint32_t));
+					mix(hash, command->indices, command->numIndices * sizeof(uint16_t));
+					mix(hash, &command->texture, sizeof(command->texture));
+					mix(hash, &command->blendMode, sizeof(command->blendMode));
+				}
+			}
+		}
+		state.clearTracks();
+		return hash;
+	}
+
+	bool readBinary(const std::string &name, Vector<unsigned char> &binary) {
+		std::string data = readFile(resourceDirectory() + name + ".skel");
+		binary.clear();
+		binary.ensureCapacity(data.size());
+		for (size_t i = 0; i < data.size(); i++) binary.add((unsigned char) data[i]);
+		return !data.empty();
+	}
+}
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SpineTests_TestSuite_h
+#define SpineTests_TestSuite_h
+
+#include <spine/spine.h>
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace spine_tests {
+	typedef void (*TestFunction)();
+
+	/// Adds a test to the list run by runTests(). Created by SPINE_TEST.
+	struct TestRegistration {
+		TestRegistration(const char *name, TestFunction function);
+	};
+
+	/// Runs the tests whose name contains the filter, or all tests if the filter is NULL.
+	/// @return The number of failed checks.
+	int runTests(const char *filter);
+
+	/// Records a failed check with its location. The test keeps running.
+	void check(bool condition, const char *expression, const char *file, int line);
+
+	/// The directory with the bundled skeletons, including the trailing slash.
+	std::string &resourceDirectory();
+
+	/// The name of every skeleton in the resource directory, each with a matching .atlas and .json file.
+	const std::vector<std::string> &skeletonNames();
+
+	std::string readFile(const std::string &path);
+
+	/// Assigns a distinct fake texture to each page, so render commands can be compared without a renderer.
+	class NullTextureLoader : public spine::TextureLoader {
+	public:
+		NullTextureLoader() : _pages(0) {}
+
+		virtual void load(spine::AtlasPage &page, const spine::String &path);
+
+		virtual void unload(void *texture);
+
+	private:
+		int _pages;
+	};
+
+	/// Loads the atlas of a bundled skeleton with a NullTextureLoader.
+	class TestAtlas {
+	public:
+		explicit TestAtlas(const std::string &name);
+
+		~TestAtlas();
+
+		spine::Atlas *get() { return _atlas; }
+
+	private:
+		NullTextureLoader _textureLoader;
+		spine::Atlas *_atlas;
+	};
+
+	/// Writes every value of the skeleton data to text, one item per line, so two loads can be compared with a
+	/// string compare and a difference can be reported by line. Lazily loaded animations are decoded first.
+	std::string dumpSkeletonData(spine::SkeletonData *skeletonData);
+
+	/// Returns the first line that differs between two dumps, or an empty string if they are equal.
+	std::string firstDifference(const std::string &expected, const std::string &actual);
+
+	/// Plays each animation for the given number of frames and hashes the render commands of every frame.
+	uint64_t hashPlayback(spine::SkeletonData *skeletonData, int frames);
+
+	/// Reads the binary export of a bundled skeleton.
+	bool readBinary(const std::string &name, spine::Vector<unsigned char> &binary);
+}
+
+#define SPINE_TEST(name) \
+	static void name(); \
+	static spine_tests::TestRegistration name##Registration(#name, name); \
+	static void name()
+
+#define CHECK(condition) spine_tests::check((condition), #condition, __FILE__, __LINE__)
+
+#endif /* SpineTests_TestSuite_h */
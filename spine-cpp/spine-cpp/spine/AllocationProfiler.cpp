@@ -0,0 +1,527 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AllocationProfiler.h>
+
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace spine;
+
+class AllocationProfiler::Site {
+public:
+	const char *file;
+	int line;
+	/* All sites form a list, newest first, that is only ever prepended to. */
+	Site *next;
+	std::atomic<size_t> allocations;
+	std::atomic<size_t> reallocations;
+	std::atomic<size_t> frees;
+	std::atomic<size_t> liveAllocations;
+	std::atomic<size_t> liveBytes;
+	std::atomic<size_t> peakBytes;
+	std::atomic<size_t> totalBytes;
+	std::atomic<size_t> frameAllocations;
+	std::atomic<size_t> frameBytes;
+	std::atomic<size_t> lastFrameAllocations;
+	std::atomic<size_t> lastFrameBytes;
+	std::atomic<size_t> maxFrameAllocations;
+
+	Site(const char *file, int line) : file(file), line(line), next(NULL), allocations(0), reallocations(0), frees(0),
+									   liveAllocations(0), liveBytes(0), peakBytes(0), totalBytes(0),
+									   frameAllocations(0), frameBytes(0), lastFrameAllocations(0), lastFrameBytes(0),
+									   maxFrameAllocations(0) {
+	}
+};
+
+struct AllocationProfiler::Record {
+	void *address;
+	size_t size;
+	Site *site;
+};
+
+struct AllocationProfiler::SiteStats {
+	const char *file;
+	int line;
+	size_t allocations;
+	size_t reallocations;
+	size_t frees;
+	size_t liveAllocations;
+	size_t liveBytes;
+	size_t peakBytes;
+	size_t totalBytes;
+	size_t lastFrameAllocations;
+	size_t lastFrameBytes;
+	size_t maxFrameAllocations;
+};
+
+namespace {
+	const size_t InitialCapacity = 256;
+
+	inline uint64_t hashPointer(const void *ptr) {
+		return (uint64_t) (uintptr_t) ptr * 0x9E3779B97F4A7C15ULL;
+	}
+
+	inline uint64_t hashSite(const char *file, int line) {
+		return ((uint64_t) (uintptr_t) file ^ ((uint64_t) (uint32_t) line << 40)) * 0x9E3779B97F4A7C15ULL;
+	}
+
+	/* Shards are picked with the top bits of a hash, slots with the bits below. */
+	inline size_t getSlot(uint64_t hash, size_t capacity) {
+		return (size_t) (hash >> 24) & (capacity - 1);
+	}
+
+	inline void updateMax(std::atomic<size_t> &max, size_t value) {
+		size_t current = max.load(std::memory_order_relaxed);
+		while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+		}
+	}
+
+	const char *getFileName(const char *file) {
+		return file ? file : "";
+	}
+
+	void writeJsonString(FILE *file, const char *str) {
+		fputc('"', file);
+		for (; *str; str++) {
+			unsigned char c = (unsigned char) *str;
+			if (c == '"' || c == '\\')
+				fprintf(file, "\\%c", c);
+			else if (c < 0x20)
+				fprintf(file, "\\u%04x", c);
+			else
+				fputc(c, file);
+		}
+		fputc('"', file);
+	}
+
+	void writeCsvString(FILE *file, const char *str) {
+		fputc('"', file);
+		for (; *str; str++) {
+			if (*str == '"') fputc('"', file);
+			fputc(*str, file);
+		}
+		fputc('"', file);
+	}
+}
+
+AllocationProfiler::AllocationProfiler(SpineExtension *extension) : _extension(extension), _sites(NULL),
+																	_allocations(0), _reallocations(0), _frees(0),
+																	_liveAllocations(0), _liveBytes(0), _peakBytes(0),
+																	_frames(0) {
+	for (int i = 0; i < SiteShardCount; i++) {
+		_siteShards[i].slots = (Site **) ::calloc(InitialCapacity, sizeof(Site *));
+		_siteShards[i].capacity = InitialCapacity;
+		_siteShards[i].count = 0;
+	}
+	for (int i = 0; i < RecordShardCount; i++) {
+		_recordShards[i].slots = (Record *) ::calloc(InitialCapacity, sizeof(Record));
+		_recordShards[i].capacity = InitialCapacity;
+		_recordShards[i].count = 0;
+	}
+}
+
+AllocationProfiler::~AllocationProfiler() {
+	for (int i = 0; i < SiteShardCount; i++)
+		::free(_siteShards[i].slots);
+	for (int i = 0; i < RecordShardCount; i++)
+		::free(_recordShards[i].slots);
+	Site *site = _sites.load();
+	while (site) {
+		Site *next = site->next;
+		site->~Site();
+		::free(site);
+		site = next;
+	}
+}
+
+AllocationProfiler::Site *AllocationProfiler::getSite(const char *file, int line) {
+	uint64_t hash = hashSite(file, line);
+	SiteShard &shard = _siteShards[hash >> 60];
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	size_t mask = shard.capacity - 1;
+	size_t slot = getSlot(hash, shard.capacity);
+	for (Site *site; (site = shard.slots[slot]) != NULL; slot = (slot + 1) & mask)
+		if (site->file == file && site->line == line) return site;
+
+	Site *site = new (::malloc(sizeof(Site))) Site(file, line);
+	site->next = _sites.load(std::memory_order_relaxed);
+	while (!_sites.compare_exchange_weak(site->next, site)) {
+	}
+	shard.slots[slot] = site;
+	if (++shard.count * 2 > shard.capacity) {
+		size_t capacity = shard.capacity * 2;
+		Site **slots = (Site **) ::calloc(capacity, sizeof(Site *));
+		for (size_t i = 0; i < shard.capacity; i++) {
+			Site *entry = shard.slots[i];
+			if (!entry) continue;
+			size_t index = getSlot(hashSite(entry->file, entry->line), capacity);
+			while (slots[index]) index = (index + 1) & (capacity - 1);
+			slots[index] = entry;
+		}
+		::free(shard.slots);
+		shard.slots = slots;
+		shard.capacity = capacity;
+	}
+	return site;
+}
+
+void AllocationProfiler::track(void *ptr, size_t size, Site *site) {
+	uint64_t hash = hashPointer(ptr);
+	RecordShard &shard = _recordShards[hash >> 58];
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		size_t mask = shard.capacity - 1;
+		size_t slot = getSlot(hash, shard.capacity);
+		while (shard.slots[slot].address && shard.slots[slot].address != ptr)
+			slot = (slot + 1) & mask;
+		if (!shard.slots[slot].address) shard.count++;
+		Record &record = shard.slots[slot];
+		record.address = ptr;
+		record.size = size;
+		record.site = site;
+		if (shard.count * 2 > shard.capacity) {
+			size_t capacity = shard.capacity * 2;
+			Record *slots = (Record *) ::calloc(capacity, sizeof(Record));
+			for (size_t i = 0; i < shard.capacity; i++) {
+				Record &entry = shard.slots[i];
+				if (!entry.address) continue;
+				size_t index = getSlot(hashPointer(entry.address), capacity);
+				while (slots[index].address) index = (index + 1) & (capacity - 1);
+				slots[index] = entry;
+			}
+			::free(shard.slots);
+			shard.slots = slots;
+			shard.capacity = capacity;
+		}
+	}
+
+	site->liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	updateMax(site->peakBytes, site->liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+	site->totalBytes.fetch_add(size, std::memory_order_relaxed);
+	site->frameAllocations.fetch_add(1, std::memory_order_relaxed);
+	site->frameBytes.fetch_add(size, std::memory_order_relaxed);
+	_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+	updateMax(_peakBytes, _liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+}
+
+bool AllocationProfiler::untrack(void *ptr, size_t &size, Site *&site) {
+	uint64_t hash = hashPointer(ptr);
+	RecordShard &shard = _recordShards[hash >> 58];
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		size_t mask = shard.capacity - 1;
+		size_t slot = getSlot(hash, shard.capacity);
+		while (shard.slots[slot].address != ptr) {
+			if (!shard.slots[slot].address) return false;
+			slot = (slot + 1) & mask;
+		}
+		size = shard.slots[slot].size;
+		site = shard.slots[slot].site;
+		shard.count--;
+
+		/* Move later records of the same run back into the hole, so lookups never stop early. */
+		for (size_t next = (slot + 1) & mask; shard.slots[next].address; next = (next + 1) & mask) {
+			size_t home = getSlot(hashPointer(shard.slots[next].address), shard.capacity);
+			if (((next - home) & mask) >= ((next - slot) & mask)) {
+				shard.slots[slot] = shard.slots[next];
+				slot = next;
+			}
+		}
+		shard.slots[slot].address = NULL;
+	}
+
+	site->liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	site->liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	_liveBytes.fetch_sub(size, std::memory_order_relaxed);
+	return true;
+}
+
+void *AllocationProfiler::_alloc(size_t size, const char *file, int line) {
+	void *result = _extension->_alloc(size, file, line);
+	if (!result) return result;
+	Site *site = getSite(file, line);
+	site->allocations.fetch_add(1, std::memory_order_relaxed);
+	_allocations.fetch_add(1, std::memory_order_relaxed);
+	track(result, size, site);
+	return result;
+}
+
+void *AllocationProfiler::_calloc(size_t size, const char *file, int line) {
+	void *result = _extension->_calloc(size, file, line);
+	if (!result) return result;
+	Site *site = getSite(file, line);
+	site->allocations.fetch_add(1, std::memory_order_relaxed);
+	_allocations.fetch_add(1, std::memory_order_relaxed);
+	track(result, size, site);
+	return result;
+}
+
+void *AllocationProfiler::_realloc(void *ptr, size_t size, const char *file, int line) {
+	size_t oldSize = 0;
+	Site *oldSite = NULL;
+	bool tracked = ptr && untrack(ptr, oldSize, oldSite);
+	void *result = _extension->_realloc(ptr, size, file, line);
+	if (!result) {
+		/* A failed reallocation leaves the memory as it was, one to size 0 frees it. */
+		if (tracked && size)
+			track(ptr, oldSize, oldSite);
+		else if (tracked) {
+			oldSite->frees.fetch_add(1, std::memory_order_relaxed);
+			_frees.fetch_add(1, std::memory_order_relaxed);
+		}
+		return result;
+	}
+	/* The memory is now attributed to the site that resized it. */
+	Site *site = getSite(file, line);
+	site->reallocations.fetch_add(1, std::memory_order_relaxed);
+	_reallocations.fetch_add(1, std::memory_order_relaxed);
+	track(result, size, site);
+	return result;
+}
+
+void AllocationProfiler::_free(void *mem, const char *file, int line) {
+	if (mem) {
+		size_t size;
+		Site *site;
+		if (untrack(mem, size, site)) {
+			site->frees.fetch_add(1, std::memory_order_relaxed);
+			_frees.fetch_add(1, std::memory_order_relaxed);
+		} else
+			untrackedFree(mem, file, line);
+	}
+	_extension->_free(mem, file, line);
+}
+
+char *AllocationProfiler::_readFile(const String &path, int *length) {
+	char *data = _extension->_readFile(path, length);
+	/* Extensions that read files through SpineExtension::alloc() are already tracked. */
+	size_t size;
+	Site *site;
+	if (data && !untrack(data, size, site)) {
+		site = getSite(__FILE__, __LINE__);
+		site->allocations.fetch_add(1, std::memory_order_relaxed);
+		_allocations.fetch_add(1, std::memory_order_relaxed);
+		size = (size_t) *length;
+	}
+	if (data) track(data, size, site);
+	return data;
+}
+
+bool AllocationProfiler::_mapFile(const String &path, MappedFile &file) {
+	return _extension->_mapFile(path, file);
+}
+
+void AllocationProfiler::_unmapFile(MappedFile &file) {
+	_extension->_unmapFile(file);
+}
+
+void AllocationProfiler::_beforeFree(void *ptr) {
+	_extension->_beforeFree(ptr);
+}
+
+void AllocationProfiler::untrackedFree(void *mem, const char *file, int line) {
+	SP_UNUSED(mem);
+	SP_UNUSED(file);
+	SP_UNUSED(line);
+}
+
+void AllocationProfiler::endFrame() {
+	for (Site *site = _sites.load(); site; site = site->next) {
+		size_t allocations = site->frameAllocations.exchange(0, std::memory_order_relaxed);
+		site->lastFrameAllocations.store(allocations, std::memory_order_relaxed);
+		site->lastFrameBytes.store(site->frameBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+		updateMax(site->maxFrameAllocations, allocations);
+	}
+	_frames.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationProfiler::Totals AllocationProfiler::getTotals() {
+	Totals totals;
+	totals.allocations = _allocations.load();
+	totals.reallocations = _reallocations.load();
+	totals.frees = _frees.load();
+	totals.liveAllocations = _liveAllocations.load();
+	totals.liveBytes = _liveBytes.load();
+	totals.peakBytes = _peakBytes.load();
+	totals.frames = _frames.load();
+	return totals;
+}
+
+void AllocationProfiler::clearAllocations() {
+	for (int i = 0; i < RecordShardCount; i++) {
+		RecordShard &shard = _recordShards[i];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		for (size_t ii = 0; ii < shard.capacity; ii++) {
+			Record &record = shard.slots[ii];
+			if (!record.address) continue;
+			record.site->liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+			record.site->liveBytes.fetch_sub(record.size, std::memory_order_relaxed);
+			_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+			_liveBytes.fetch_sub(record.size, std::memory_order_relaxed);
+			record.address = NULL;
+		}
+		shard.count = 0;
+	}
+}
+
+void AllocationProfiler::visitLiveAllocations(LiveAllocationVisitor visitor, void *userData) {
+	for (int i = 0; i < RecordShardCount; i++) {
+		RecordShard &shard = _recordShards[i];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		for (size_t ii = 0; ii < shard.capacity; ii++) {
+			Record &record = shard.slots[ii];
+			if (record.address) visitor(record.address, record.size, record.site->file, record.site->line, userData);
+		}
+	}
+}
+
+int AllocationProfiler::compareLocation(const void *a, const void *b) {
+	const SiteStats &siteA = *(const SiteStats *) a;
+	const SiteStats &siteB = *(const SiteStats *) b;
+	if (siteA.line != siteB.line) return siteA.line < siteB.line ? -1 : 1;
+	return strcmp(getFileName(siteA.file), getFileName(siteB.file));
+}
+
+int AllocationProfiler::compareLiveBytes(const void *a, const void *b) {
+	const SiteStats &siteA = *(const SiteStats *) a;
+	const SiteStats &siteB = *(const SiteStats *) b;
+	if (siteA.liveBytes != siteB.liveBytes) return siteA.liveBytes > siteB.liveBytes ? -1 : 1;
+	if (siteA.totalBytes != siteB.totalBytes) return siteA.totalBytes > siteB.totalBytes ? -1 : 1;
+	return compareLocation(a, b);
+}
+
+AllocationProfiler::SiteStats *AllocationProfiler::snapshot(size_t &count) {
+	count = 0;
+	Site *sites = _sites.load();
+	for (Site *site = sites; site; site = site->next)
+		count++;
+	SiteStats *stats = (SiteStats *) ::malloc((count ? count : 1) * sizeof(SiteStats));
+	size_t i = 0;
+	for (Site *site = sites; site; site = site->next, i++) {
+		SiteStats &entry = stats[i];
+		entry.file = site->file;
+		entry.line = site->line;
+		entry.allocations = site->allocations.load(std::memory_order_relaxed);
+		entry.reallocations = site->reallocations.load(std::memory_order_relaxed);
+		entry.frees = site->frees.load(std::memory_order_relaxed);
+		entry.liveAllocations = site->liveAllocations.load(std::memory_order_relaxed);
+		entry.liveBytes = site->liveBytes.load(std::memory_order_relaxed);
+		entry.peakBytes = site->peakBytes.load(std::memory_order_relaxed);
+		entry.totalBytes = site->totalBytes.load(std::memory_order_relaxed);
+		entry.lastFrameAllocations = site->lastFrameAllocations.load(std::memory_order_relaxed);
+		entry.lastFrameBytes = site->lastFrameBytes.load(std::memory_order_relaxed);
+		entry.maxFrameAllocations = site->maxFrameAllocations.load(std::memory_order_relaxed);
+	}
+
+	/* Sites are keyed by the file name's address, which can differ between translation units for code in headers.
+	 * Merge sites with the same file name and line. Their peaks are added, so a merged peak is an upper bound. */
+	if (count > 1) {
+		qsort(stats, count, sizeof(SiteStats), compareLocation);
+		size_t merged = 0;
+		for (i = 1; i < count; i++) {
+			SiteStats &last = stats[merged], &entry = stats[i];
+			if (compareLocation(&last, &entry) != 0) {
+				stats[++merged] = entry;
+				continue;
+			}
+			last.allocations += entry.allocations;
+			last.reallocations += entry.reallocations;
+			last.frees += entry.frees;
+			last.liveAllocations += entry.liveAllocations;
+			last.liveBytes += entry.liveBytes;
+			last.peakBytes += entry.peakBytes;
+			last.totalBytes += entry.totalBytes;
+			last.lastFrameAllocations += entry.lastFrameAllocations;
+			last.lastFrameBytes += entry.lastFrameBytes;
+			last.maxFrameAllocations += entry.maxFrameAllocations;
+		}
+		count = merged + 1;
+		qsort(stats, count, sizeof(SiteStats), compareLiveBytes);
+	}
+	return stats;
+}
+
+void AllocationProfiler::writeJson(FILE *file) {
+	Totals totals = getTotals();
+	size_t count;
+	SiteStats *stats = snapshot(count);
+	fprintf(file,
+			"{\n\"frames\": %zu,\n\"allocations\": %zu,\n\"reallocations\": %zu,\n\"frees\": %zu,\n"
+			"\"liveAllocations\": %zu,\n\"liveBytes\": %zu,\n\"peakBytes\": %zu,\n\"sites\": [",
+			totals.frames, totals.allocations, totals.reallocations, totals.frees, totals.liveAllocations,
+			totals.liveBytes, totals.peakBytes);
+	for (size_t i = 0; i < count; i++) {
+		SiteStats &entry = stats[i];
+		fputs(i == 0 ? "\n{\"file\": " : ",\n{\"file\": ", file);
+		writeJsonString(file, getFileName(entry.file));
+		fprintf(file,
+				", \"line\": %d, \"allocations\": %zu, \"reallocations\": %zu, \"frees\": %zu, \"liveAllocations\": %zu, "
+				"\"liveBytes\": %zu, \"peakBytes\": %zu, \"totalBytes\": %zu, \"lastFrameAllocations\": %zu, "
+				"\"lastFrameBytes\": %zu, \"maxFrameAllocations\": %zu}",
+				entry.line, entry.allocations, entry.reallocations, entry.frees, entry.liveAllocations, entry.liveBytes,
+				entry.peakBytes, entry.totalBytes, entry.lastFrameAllocations, entry.lastFrameBytes,
+				entry.maxFrameAllocations);
+	}
+	fputs("\n]\n}\n", file);
+	::free(stats);
+}
+
+void AllocationProfiler::writeCsv(FILE *file) {
+	size_t count;
+	SiteStats *stats = snapshot(count);
+	fputs("file,line,allocations,reallocations,frees,liveAllocations,liveBytes,peakBytes,totalBytes,"
+		  "lastFrameAllocations,lastFrameBytes,maxFrameAllocations\n",
+		  file);
+	for (size_t i = 0; i < count; i++) {
+		SiteStats &entry = stats[i];
+		writeCsvString(file, getFileName(entry.file));
+		fprintf(file, ",%d,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu,%zu\n", entry.line, entry.allocations,
+				entry.reallocations, entry.frees, entry.liveAllocations, entry.liveBytes, entry.peakBytes,
+				entry.totalBytes, entry.lastFrameAllocations, entry.lastFrameBytes, entry.maxFrameAllocations);
+	}
+	::free(stats);
+}
+
+bool AllocationProfiler::saveJson(const char *path) {
+	FILE *file = fopen(path, "wb");
+	if (!file) return false;
+	writeJson(file);
+	return fclose(file) == 0;
+}
+
+bool AllocationProfiler::saveCsv(const char *path) {
+	FILE *file = fopen(path, "wb");
+	if (!file) return false;
+	writeCsv(file);
+	return fclose(file) == 0;
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AllocationProfiler_h
+#define Spine_AllocationProfiler_h
+
+#include <spine/Extension.h>
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+
+namespace spine {
+	/// A SpineExtension that passes all calls on to another extension and aggregates the allocations by call site, the
+	/// file and line given to SpineExtension::alloc() and friends. For each site it counts allocations and frees and
+	/// tracks the live and peak bytes and the allocations made per frame. Call endFrame() once per frame to measure
+	/// churn, and write a snapshot of all sites with writeJson() or writeCsv().
+	///
+	/// Live allocations are kept in hash tables split into shards with their own lock, so threads rarely wait for each
+	/// other. The profiler's own memory comes from malloc and is not reported. Install the profiler with
+	/// SpineExtension::setInstance() before spine-cpp allocates anything, or frees of earlier allocations are reported
+	/// to untrackedFree().
+	class SP_API AllocationProfiler : public SpineExtension {
+	public:
+		struct Totals {
+			size_t allocations;
+			size_t reallocations;
+			size_t frees;
+			size_t liveAllocations;
+			size_t liveBytes;
+			size_t peakBytes;
+			/// The number of calls to endFrame().
+			size_t frames;
+		};
+
+		explicit AllocationProfiler(SpineExtension *extension);
+
+		virtual ~AllocationProfiler();
+
+		/// Ends the current frame. The allocations made since the previous call become the last frame's churn.
+		void endFrame();
+
+		Totals getTotals();
+
+		/// Forgets all live allocations, e.g. those made while loading, so later snapshots only show what was allocated
+		/// since. Counters are kept.
+		void clearAllocations();
+
+		/// Writes the totals and one object per call site, ordered by live bytes.
+		void writeJson(FILE *file);
+
+		/// Writes a header row and one row per call site, ordered by live bytes.
+		void writeCsv(FILE *file);
+
+		bool saveJson(const char *path);
+
+		bool saveCsv(const char *path);
+
+		virtual void *_alloc(size_t size, const char *file, int line) override;
+
+		virtual void *_calloc(size_t size, const char *file, int line) override;
+
+		virtual void *_realloc(void *ptr, size_t size, const char *file, int line) override;
+
+		virtual void _free(void *mem, const char *file, int line) override;
+
+		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual bool _mapFile(const String &path, MappedFile &file) override;
+
+		virtual void _unmapFile(MappedFile &file) override;
+
+		virtual void _beforeFree(void *ptr) override;
+
+	protected:
+		typedef void (*LiveAllocationVisitor)(void *address, size_t size, const char *file, int line, void *userData);
+
+		/// Called when memory is freed that the profiler did not see being allocated.
+		virtual void untrackedFree(void *mem, const char *file, int line);
+
+		/// Calls the visitor for each live allocation, one shard at a time. The visitor must not allocate.
+		void visitLiveAllocations(LiveAllocationVisitor visitor, void *userData);
+
+	private:
+		static const int SiteShardCount = 16;
+		static const int RecordShardCount = 64;
+
+		class Site;
+
+		struct Record;
+
+		struct SiteShard {
+			std::mutex mutex;
+			Site **slots;
+			size_t capacity;
+			size_t count;
+		};
+
+		struct RecordShard {
+			std::mutex mutex;
+			Record *slots;
+			size_t capacity;
+			size_t count;
+		};
+
+		struct SiteStats;
+
+		SpineExtension *_extension;
+		SiteShard _siteShards[SiteShardCount];
+		RecordShard _recordShards[RecordShardCount];
+		std::atomic<Site *> _sites;
+		std::atomic<size_t> _allocations;
+		std::atomic<size_t> _reallocations;
+		std::atomic<size_t> _frees;
+		std::atomic<size_t> _liveAllocations;
+		std::atomic<size_t> _liveBytes;
+		std::atomic<size_t> _peakBytes;
+		std::atomic<size_t> _frames;
+
+		Site *getSite(const char *file, int line);
+
+		void track(void *ptr, size_t size, Site *site);
+
+		bool untrack(void *ptr, size_t &size, Site *&site);
+
+		SiteStats *snapshot(size_t &count);
+
+		static int compareLocation(const void *a, const void *b);
+
+		static int compareLiveBytes(const void *a, const void *b);
+	};
+}
+
+#endif /* Spine_AllocationProfiler_h */
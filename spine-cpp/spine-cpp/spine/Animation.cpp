@@ -41,13 +41,15 @@ using namespace spine;
 Animation::Animation(const String &name, Vector<Timeline *> &timelines, float duration) : _timelines(timelines),
 																						  _timelineIds(),
 																						  _duration(duration),
-																						  _name(name) {
+																						  _name(name),
+																						  _loaded(true),
+																						  _evictable(false),
+																						  _kept(false),
+																						  _useCount(0),
+																						  _index(-1),
+																						  _decoder(NULL) {
 	assert(_name.length() > 0);
-	for (size_t i = 0; i < timelines.size(); i++) {
-		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
-		for (size_t ii = 0; ii < propertyIds.size(); ii++)
-			_timelineIds.put(propertyIds[ii], true);
-	}
+	setTimelines(_timelines);
 }
 
 bool Animation::hasTimeline(Vector<PropertyId> &ids) {
@@ -63,6 +65,7 @@ Animation::~Animation() {
 
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 					  MixBlend blend, MixDirection direction) {
+	assert(_loaded && "A lazily loaded animation must be loaded or acquired before it is applied.");
 	if (loop && _duration != 0) {
 		time = MathUtil::fmod(time, _duration);
 		if (lastTime > 0) {
@@ -91,6 +94,23 @@ void Animation::setDuration(float inValue) {
 	_duration = inValue;
 }
 
+bool Animation::isLoaded() {
+	return _loaded;
+}
+
+void Animation::setTimelines(Vector<Timeline *> &timelines) {
+	if (&_timelines != &timelines) {
+		ContainerUtil::cleanUpVectorOfPointers(_timelines);
+		_timelines.clearAndAddAll(timelines);
+	}
+	_timelineIds.clear();
+	for (size_t i = 0; i < _timelines.size(); i++) {
+		Vector<PropertyId> &propertyIds = _timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < propertyIds.size(); ii++)
+			_timelineIds.put(propertyIds[ii], true);
+	}
+}
+
 int Animation::search(Vector<float> &frames, float target) {
 	size_t n = (int) frames.size();
 	for (size_t i = 1; i < n; i++) {
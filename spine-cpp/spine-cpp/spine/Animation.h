@@ -47,6 +47,8 @@ namespace spine {
 
 	class AnimationState;
 
+	class AnimationDecoder;
+
 	class SP_API Animation : public SpineObject {
 		friend class AnimationState;
 
@@ -54,6 +56,8 @@ namespace spine {
 
 		friend class AnimationStateData;
 
+		friend class AnimationDecoder;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -112,6 +116,8 @@ namespace spine {
 
 		bool hasTimeline(Vector<PropertyId> &ids);
 
+		/// The duration of the animation in seconds. For lazily loaded skeleton data this is 0 until the animation
+		/// has been decoded.
 		float getDuration();
 
 		void setDuration(float inValue);
@@ -120,11 +126,24 @@ namespace spine {
 		static int search(Vector<float> &values, float target);
 
 		static int search(Vector<float> &values, float target, int step);
+
+		/// False if the skeleton data was loaded lazily and the animation's timelines have not been decoded yet, or
+		/// were unloaded. See SkeletonData::loadAnimation().
+		bool isLoaded();
+
 	private:
 		Vector<Timeline *> _timelines;
 		HashMap<PropertyId, bool> _timelineIds;
 		float _duration;
 		String _name;
+		bool _loaded;
+		bool _evictable;
+		bool _kept;
+		int _useCount;
+		int _index;
+		AnimationDecoder *_decoder;
+
+		void setTimelines(Vector<Timeline *> &timelines);
 	};
 }
 
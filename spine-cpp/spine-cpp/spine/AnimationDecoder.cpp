@@ -0,0 +1,202 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AnimationDecoder.h>
+
+#include <spine/Animation.h>
+#include <spine/ContainerUtil.h>
+#include <spine/CurveTimeline.h>
+#include <spine/DataArena.h>
+#include <spine/DeformTimeline.h>
+#include <spine/SkeletonData.h>
+#include <spine/Timeline.h>
+
+using namespace spine;
+
+AnimationDecoder::AnimationDecoder() : _skeletonData(NULL), _memoryUsed(0), _memoryBudget(0), _useCounter(0) {
+}
+
+AnimationDecoder::~AnimationDecoder() {
+	waitForPrefetch();
+}
+
+void AnimationDecoder::setSkeletonData(SkeletonData *skeletonData) {
+	_skeletonData = skeletonData;
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	_memory.setSize(animations.size(), 0);
+	_lastUsed.setSize(animations.size(), 0);
+	for (size_t i = 0; i < animations.size(); i++) {
+		animations[i]->_loaded = false;
+		animations[i]->_index = (int) i;
+		animations[i]->_decoder = this;
+	}
+}
+
+bool AnimationDecoder::load(Animation *animation) {
+	return load(animation, Use_Keep);
+}
+
+bool AnimationDecoder::acquire(Animation *animation) {
+	return load(animation, Use_Acquire);
+}
+
+void AnimationDecoder::release(Animation *animation) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (animation->_decoder != this || animation->_useCount == 0) return;
+	if (--animation->_useCount == 0) animation->_evictable = true;
+}
+
+bool AnimationDecoder::load(Animation *animation, Use use) {
+	if (animation->_decoder != this) return true;
+	int index = animation->_index;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_lastUsed[index] = ++_useCounter;
+		if (animation->_loaded) {
+			useLoaded(animation, use);
+			return true;
+		}
+	}
+
+	/* Decode without holding the lock, so loaded animations stay available while another thread decodes. If two
+	 * threads decode the same animation, the second result is discarded. Decoded timelines are freed on eviction,
+	 * so they never come from an arena installed by the caller. */
+	DataArena::Scope heap(NULL);
+	String error;
+	Animation *decoded = decode(_skeletonData, index, error);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!decoded) {
+		_error = error;
+		return false;
+	}
+	if (!animation->_loaded) {
+		animation->setTimelines(decoded->_timelines);
+		decoded->_timelines.clear();
+		animation->_duration = decoded->_duration;
+		animation->_loaded = true;
+		animation->_evictable = false;
+		animation->_kept = false;
+		_memory[index] = estimateMemory(animation);
+		_memoryUsed += _memory[index];
+	}
+	delete decoded;
+	/* The use is applied under the same lock that published the timelines, so the animation can't be evicted before
+	 * the caller's reference is taken. */
+	useLoaded(animation, use);
+	if (use != Use_Prefetch && _memoryBudget != 0) evict(_memoryBudget, animation);
+	return true;
+}
+
+void AnimationDecoder::useLoaded(Animation *animation, Use use) {
+	/* A plain load is never undone by releases, as its caller, e.g. a track entry, has no release to call. */
+	if (use == Use_Keep)
+		animation->_kept = true;
+	else if (use == Use_Acquire)
+		animation->_useCount++;
+}
+
+void AnimationDecoder::unload(Animation *animation) {
+	if (animation->_decoder != this) return;
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!animation->_loaded || animation->_useCount > 0) return;
+	unloadLocked(animation->_index);
+}
+
+void AnimationDecoder::unloadLocked(int index) {
+	Animation *animation = _skeletonData->getAnimations()[index];
+	ContainerUtil::cleanUpVectorOfPointers(animation->_timelines);
+	animation->setTimelines(animation->_timelines);
+	animation->_loaded = false;
+	animation->_evictable = false;
+	animation->_kept = false;
+	_memoryUsed -= _memory[index];
+	_memory[index] = 0;
+}
+
+void AnimationDecoder::evict(size_t memoryBudget) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	evict(memoryBudget, NULL);
+}
+
+void AnimationDecoder::evict(size_t memoryBudget, Animation *keep) {
+	Vector<Animation *> &animations = _skeletonData->getAnimations();
+	while (_memoryUsed > memoryBudget) {
+		int oldest = -1;
+		for (size_t i = 0, n = animations.size(); i < n; i++) {
+			Animation *animation = animations[i];
+			if (!animation->_loaded || !animation->_evictable || animation->_kept || animation->_useCount > 0 ||
+				animation == keep)
+				continue;
+			if (oldest == -1 || _lastUsed[i] < _lastUsed[oldest]) oldest = (int) i;
+		}
+		if (oldest == -1) break;
+		unloadLocked(oldest);
+	}
+}
+
+size_t AnimationDecoder::getMemoryUsed() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _memoryUsed;
+}
+
+void AnimationDecoder::prefetch(const Vector<String> &animationNames) {
+	waitForPrefetch();
+	_prefetchNames.clearAndAddAll(animationNames);
+	_prefetchThread = std::thread(prefetchTask, this);
+}
+
+void AnimationDecoder::waitForPrefetch() {
+	if (_prefetchThread.joinable()) _prefetchThread.join();
+}
+
+void AnimationDecoder::prefetchTask(AnimationDecoder *decoder) {
+	for (size_t i = 0; i < decoder->_prefetchNames.size(); i++) {
+		SkeletonData *skeletonData = decoder->_skeletonData;
+		Animation *animation = skeletonData->_animationIndex.findItem(skeletonData->_animations, decoder->_prefetchNames[i]);
+		if (animation) decoder->load(animation, Use_Prefetch);
+	}
+}
+
+size_t AnimationDecoder::estimateMemory(Animation *animation) {
+	Vector<Timeline *> &timelines = animation->_timelines;
+	size_t memory = timelines.size() * sizeof(Timeline *);
+	for (size_t i = 0; i < timelines.size(); i++) {
+		Timeline *timeline = timelines[i];
+		memory += sizeof(CurveTimeline) + timeline->getFrames().size() * sizeof(float);
+		if (timeline->getRTTI().instanceOf(CurveTimeline::rtti))
+			memory += static_cast<CurveTimeline *>(timeline)->getCurves().size() * sizeof(float);
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			Vector<Vector<float> > &vertices = static_cast<DeformTimeline *>(timeline)->getVertices();
+			for (size_t ii = 0; ii < vertices.size(); ii++)
+				memory += sizeof(Vector<float>) + vertices[ii].size() * sizeof(float);
+		}
+	}
+	return memory;
+}
@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AnimationDecoder_h
+#define Spine_AnimationDecoder_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+#include <mutex>
+#include <thread>
+
+namespace spine {
+	class Animation;
+
+	class SkeletonData;
+
+	/// Decodes the animations of lazily loaded skeleton data the first time they are needed. Created by SkeletonJson
+	/// and SkeletonBinary when lazy animations are enabled and owned by the SkeletonData, see
+	/// SkeletonData::getAnimationDecoder(). The decoder keeps the encoded animations in memory, so the source file can
+	/// be released after loading.
+	///
+	/// Animations are decoded by SkeletonData::findAnimation(), SkeletonData::loadAnimation(), load() and when an
+	/// AnimationState sets or adds an animation. An animation loaded that way stays loaded, so the Animation returned
+	/// by findAnimation() can be kept and played at any time. Eviction is opt-in: only an animation that was acquired
+	/// with acquire(), released by every acquirer and not loaded any other way since it was decoded may be unloaded by
+	/// evict() or the memory budget. Applying an animation that is not loaded asserts.
+	///
+	/// Decoding allocates through SpineExtension, so the extension's allocator must be thread-safe when prefetch()
+	/// is used.
+	class SP_API AnimationDecoder : public SpineObject {
+		friend class SkeletonData;
+
+	public:
+		AnimationDecoder();
+
+		virtual ~AnimationDecoder();
+
+		/// Decodes the animation's timelines if it isn't loaded. The animation is then never evicted, also after it is
+		/// acquired and released, until it is unloaded with unload().
+		/// @return False if decoding failed, see getError().
+		bool load(Animation *animation);
+
+		/// Decodes the animation if it isn't loaded and keeps it loaded until release() is called. Once every
+		/// acquire has been released, the animation may be evicted.
+		/// @return False if decoding failed, see getError(). The animation is not acquired then.
+		bool acquire(Animation *animation);
+
+		/// Releases an animation acquired with acquire(). It must not be applied after its last release unless it is
+		/// loaded again.
+		void release(Animation *animation);
+
+		/// Unloads the animation's timelines. The Animation instance stays valid and is decoded again when next
+		/// needed, but must not be applied until then. Does nothing if the animation is acquired.
+		void unload(Animation *animation);
+
+		/// Starts decoding the named animations on a background thread and returns immediately. Waits for a
+		/// previous prefetch to complete first.
+		void prefetch(const Vector<String> &animationNames);
+
+		/// Blocks until the current prefetch, if any, has completed.
+		void waitForPrefetch();
+
+		/// Unloads the least recently used animations that were only acquired and were released by every acquirer,
+		/// until the estimated memory of the loaded animations is at most the given number of bytes.
+		void evict(size_t memoryBudget);
+
+		/// The estimated bytes used by the decoded timelines of the lazily loaded animations.
+		size_t getMemoryUsed();
+
+		/// When not 0, evict() is called with this budget each time an animation is loaded or acquired on the calling
+		/// thread.
+		void setMemoryBudget(size_t memoryBudget) { _memoryBudget = memoryBudget; }
+
+		size_t getMemoryBudget() { return _memoryBudget; }
+
+		/// The error from the last failed decode.
+		String &getError() { return _error; }
+
+	protected:
+		/// Decodes the animation at the given index of SkeletonData::getAnimations(). May be called concurrently
+		/// from the prefetch thread and must only read the skeleton data and encoded animations.
+		/// @return NULL if decoding failed, with error set.
+		virtual Animation *decode(SkeletonData *skeletonData, int index, String &error) = 0;
+
+	private:
+		SkeletonData *_skeletonData;
+		Vector<size_t> _memory;
+		Vector<size_t> _lastUsed;
+		size_t _memoryUsed;
+		size_t _memoryBudget;
+		size_t _useCounter;
+		String _error;
+		std::mutex _mutex;
+		std::thread _prefetchThread;
+		Vector<String> _prefetchNames;
+
+		/* How a load affects eviction of the animation. */
+		enum Use {
+			Use_Keep,
+			Use_Acquire,
+			Use_Prefetch
+		};
+
+		void setSkeletonData(SkeletonData *skeletonData);
+
+		bool load(Animation *animation, Use use);
+
+		void useLoaded(Animation *animation, Use use);
+
+		void evict(size_t memoryBudget, Animation *keep);
+
+		void unloadLocked(int index);
+
+		static void prefetchTask(AnimationDecoder *decoder);
+
+		static size_t estimateMemory(Animation *animation);
+	};
+}
+
+#endif /* Spine_AnimationDecoder_h */
@@ -29,6 +29,7 @@
 
 #include <spine/AnimationState.h>
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/AnimationStateData.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/Bone.h>
@@ -36,6 +37,7 @@
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
 #include <spine/EventTimeline.h>
+#include <spine/FrameArena.h>
 #include <spine/RotateTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonData.h>
@@ -333,12 +335,18 @@ void EventQueue::drain() {
 
 AnimationState::AnimationState(AnimationStateData *data) : _data(data),
 														   _queue(EventQueue::newEventQueue(*this)),
+														   _propertyIDs(NULL),
+														   _propertyIDMask(0),
 														   _animationsChanged(false),
+														   _timelineCapacity(0),
 														   _listener(dummyOnAnimationEventFunc),
 														   _listenerObject(NULL),
 														   _unkeyedState(0),
 														   _timeScale(1),
 														   _manualTrackEntryDisposal(false) {
+	Vector<Animation *> &animations = data->getSkeletonData()->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++)
+		_timelineCapacity = MathUtil::max(_timelineCapacity, animations[i]->_timelines.size());
 }
 
 AnimationState::~AnimationState() {
@@ -349,15 +357,15 @@ AnimationState::~AnimationState() {
 			while (from) {
 				TrackEntry *curr = from;
 				from = curr->_mixingFrom;
-				delete curr;
+				disposeTrackEntry(curr);
 			}
 			TrackEntry *next = entry->_next;
 			while (next) {
 				TrackEntry *curr = next;
 				next = curr->_next;
-				delete curr;
+				disposeTrackEntry(curr);
 			}
-			delete entry;
+			disposeTrackEntry(entry);
 		}
 	}
 	delete _queue;
@@ -464,6 +472,7 @@ bool AnimationState::apply(Skeleton &skeleton) {
 			applyTime = current._animation->getDuration() - applyTime;
 			applyEvents = NULL;
 		}
+		assert(current._animation->_loaded && "A lazily loaded animation was unloaded while set on a track.");
 		size_t timelineCount = current._animation->_timelines.size();
 		Vector<Timeline *> &timelines = current._animation->_timelines;
 		if ((i == 0 && alpha == 1) || blend == MixBlend_Add) {
@@ -836,6 +845,7 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 	}
 
 	bool attachments = mix < from->_mixAttachmentThreshold, drawOrder = mix < from->_mixDrawOrderThreshold;
+	assert(from->_animation->_loaded && "A lazily loaded animation was unloaded while set on a track.");
 	Vector<Timeline *> &timelines = from->_animation->_timelines;
 	size_t timelineCount = timelines.size();
 	float alphaHold = from->_alpha * to->_interruptAlpha, alphaMix = alphaHold * (1 - mix);
@@ -994,6 +1004,15 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry *entryP = _trackEntryPool.obtain();// Pooling
 	TrackEntry &entry = *entryP;
 
+	if (animation->_decoder) animation->_decoder->load(animation);
+
+	/* Pooled entries keep their per timeline arrays. Sizing them for the longest animation up front means an entry
+	 * allocates them once, rather than again each time it is reused for a longer animation. */
+	_timelineCapacity = MathUtil::max(_timelineCapacity, animation->_timelines.size());
+	entry._timelineMode.ensureCapacity(_timelineCapacity);
+	entry._timelineHoldMix.ensureCapacity(_timelineCapacity);
+	entry._timelinesRotation.ensureCapacity(_timelineCapacity << 1);
+
 	entry._trackIndex = (int) trackIndex;
 	entry._animation = animation;
 	entry._loop = loop;
@@ -1041,7 +1060,23 @@ void AnimationState::clearNext(TrackEntry *entry) {
 void AnimationState::animationsChanged() {
 	_animationsChanged = false;
 
-	_propertyIDs.clear();
+	/* The set is sized for all property IDs of the track entries, at most half full. It is only needed until the hold
+	 * modes are computed, so it comes from the frame arena if there is one. */
+	size_t propertyCount = 0;
+	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
+		for (TrackEntry *entry = _tracks[i]; entry; entry = entry->_mixingFrom) {
+			Vector<Timeline *> &timelines = entry->_animation->_timelines;
+			for (size_t ii = 0, nn = timelines.size(); ii < nn; ++ii)
+				propertyCount += timelines[ii]->getPropertyIds().size();
+		}
+	}
+	size_t capacity = 16;
+	while (capacity < propertyCount * 2)
+		capacity <<= 1;
+	_propertyIDs = FrameArena::allocate(_propertyIDBuffer, capacity);
+	_propertyIDMask = capacity - 1;
+	for (size_t i = 0; i < capacity; i++)
+		_propertyIDs[i] = EmptyPropertyId;
 
 	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
 		TrackEntry *entry = _tracks[i];
@@ -1055,6 +1090,8 @@ void AnimationState::animationsChanged() {
 			entry = entry->_mixingTo;
 		} while (entry != NULL);
 	}
+
+	_propertyIDs = NULL;
 }
 
 void AnimationState::computeHold(TrackEntry *entry) {
@@ -1068,7 +1105,7 @@ void AnimationState::computeHold(TrackEntry *entry) {
 
 	if (to != NULL && to->_holdPrevious) {
 		for (size_t i = 0; i < timelinesCount; i++) {
-			timelineMode[i] = _propertyIDs.addAll(timelines[i]->getPropertyIds(), true) ? HoldFirst : HoldSubsequent;
+			timelineMode[i] = addPropertyIds(timelines[i]->getPropertyIds()) ? HoldFirst : HoldSubsequent;
 		}
 		return;
 	}
@@ -1079,7 +1116,7 @@ continue_outer:
 	for (; i < timelinesCount; ++i) {
 		Timeline *timeline = timelines[i];
 		Vector<PropertyId> &ids = timeline->getPropertyIds();
-		if (!_propertyIDs.addAll(ids, true)) {
+		if (!addPropertyIds(ids)) {
 			timelineMode[i] = Subsequent;
 		} else {
 			if (to == NULL || timeline->getRTTI().isExactly(AttachmentTimeline::rtti) ||
@@ -1102,3 +1139,20 @@ continue_outer:
 		}
 	}
 }
+
+bool AnimationState::addPropertyIds(Vector<PropertyId> &ids) {
+	bool added = false;
+	for (size_t i = 0, n = ids.size(); i < n; i++) {
+		PropertyId id = ids[i];
+		size_t slot = (size_t) (((unsigned long long) id * 0x9E3779B97F4A7C15ULL) >> 32) & _propertyIDMask;
+		while (_propertyIDs[slot] != id) {
+			if (_propertyIDs[slot] == EmptyPropertyId) {
+				_propertyIDs[slot] = id;
+				added = true;
+				break;
+			}
+			slot = (slot + 1) & _propertyIDMask;
+		}
+	}
+	return added;
+}
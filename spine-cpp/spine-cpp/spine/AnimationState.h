@@ -463,6 +463,10 @@ namespace spine {
 		static const int Setup = 1;
 		static const int Current = 2;
 
+		/* Property IDs are a property shifted left by 32 bits, or'ed with an index that is -1 or more, so they never
+		 * have only the sign bit set. */
+		static const PropertyId EmptyPropertyId = (PropertyId) 1 << 63;
+
 		AnimationStateData *_data;
 
 		Pool<TrackEntry> _trackEntryPool;
@@ -470,9 +474,15 @@ namespace spine {
 		Vector<Event *> _events;
 		EventQueue *_queue;
 
-		HashMap<PropertyId, bool> _propertyIDs;
+		/* Open addressing set of the property IDs seen while computing hold modes, see animationsChanged(). */
+		Vector<PropertyId> _propertyIDBuffer;
+		PropertyId *_propertyIDs;
+		size_t _propertyIDMask;
 		bool _animationsChanged;
 
+		/* The most timelines of any animation played, which the per timeline arrays of track entries are sized for. */
+		size_t _timelineCapacity;
+
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
 
@@ -514,6 +524,9 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
+		/// Returns true if any of the IDs was not in the property ID set yet.
+		bool addPropertyIds(Vector<PropertyId> &ids);
+
 		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
 	};
 }
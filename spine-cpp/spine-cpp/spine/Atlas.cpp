@@ -31,15 +31,11 @@
 #include <spine/ContainerUtil.h>
 #include <spine/TextureLoader.h>
 
-#include <ctype.h>
-
 using namespace spine;
 
 Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader) {
 	int dirLength;
 	char *dir;
-	int length;
-	const char *data;
 
 	/* Get directory from atlas path. */
 	const char *lastForwardSlash = strrchr(path.buffer(), '/');
@@ -51,12 +47,13 @@ Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTextur
 	memcpy(dir, path.buffer(), dirLength);
 	dir[dirLength] = '\0';
 
-	data = SpineExtension::readFile(path, &length);
-	if (data) {
-		load(data, length, dir, createTexture);
+	MappedFile file;
+	if (SpineExtension::mapFile(path, file)) {
+		load(file.data, file.length, dir, createTexture);
 	}
+	updateIndex();
 
-	SpineExtension::free(data, __FILE__, __LINE__);
+	SpineExtension::unmapFile(file);
 	SpineExtension::free(dir, __FILE__, __LINE__);
 }
 
@@ -64,6 +61,7 @@ Atlas::Atlas(const char *data, int length, const char *dir, TextureLoader *textu
 	: _textureLoader(
 			  textureLoader) {
 	load(data, length, dir, createTexture);
+	updateIndex();
 }
 
 Atlas::~Atlas() {
@@ -86,9 +84,15 @@ void Atlas::flipV() {
 }
 
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
-	return NULL;
+	return _regionIndex.findItem(_regions, name);
+}
+
+AtlasRegion *Atlas::findRegion(const NameHash &name) {
+	return _regionIndex.findItem(_regions, name);
+}
+
+void Atlas::updateIndex() {
+	_regionIndex.update(_regions);
 }
 
 Vector<AtlasPage *> &Atlas::getPages() {
@@ -99,128 +103,113 @@ Vector<AtlasRegion *> &Atlas::getRegions() {
 	return _regions;
 }
 
-struct SimpleString {
-	char *start;
-	char *end;
-	int length;
+namespace {
+	inline bool isSpace(char c) {
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	/* A range of the atlas text. Only names that are kept are copied out of it. */
+	struct AtlasToken {
+		const char *start;
+		const char *end;
 
-	SimpleString trim() {
-		while (isspace((unsigned char) *start) && start < end)
-			start++;
-		if (start == end) {
-			length = (int) (end - start);
-			return *this;
+		int length() const {
+			return (int) (end - start);
 		}
-		end--;
-		while (((unsigned char) *end == '\r') && end >= start)
-			end--;
-		end++;
-		length = (int) (end - start);
-		return *this;
-	}
 
-	int indexOf(char needle) {
-		char *c = start;
-		while (c < end) {
-			if (*c == needle) return (int) (c - start);
-			c++;
+		bool equals(const char *str, int strLength) const {
+			return length() == strLength && memcmp(start, str, strLength) == 0;
 		}
-		return -1;
-	}
 
-	int indexOf(char needle, int at) {
-		char *c = start + at;
-		while (c < end) {
-			if (*c == needle) return (int) (c - start);
-			c++;
+		template<size_t N>
+		bool equals(const char (&str)[N]) const {
+			return equals(str, (int) N - 1);
 		}
-		return -1;
-	}
 
-	SimpleString substr(int s, int e) {
-		e = s + e;
-		SimpleString result;
-		result.start = start + s;
-		result.end = start + e;
-		result.length = e - s;
-		return result;
-	}
+		bool contains(char c) const {
+			return memchr(start, c, length()) != NULL;
+		}
 
-	SimpleString substr(int s) {
-		SimpleString result;
-		result.start = start + s;
-		result.end = end;
-		result.length = (int) (result.end - result.start);
-		return result;
-	}
+		char *copy() const {
+			char *string = SpineExtension::calloc<char>(length() + 1, __FILE__, __LINE__);
+			memcpy(string, start, length());
+			string[length()] = '\0';
+			return string;
+		}
 
-	bool equals(const char *str) {
-		int otherLen = (int) strlen(str);
-		if (length != otherLen) return false;
-		for (int i = 0; i < length; i++) {
-			if (start[i] != str[i]) return false;
+		int toInt() const {
+			const char *c = start;
+			bool negative = false;
+			if (c < end && (*c == '-' || *c == '+')) negative = *c++ == '-';
+			int value = 0;
+			while (c < end && *c >= '0' && *c <= '9')
+				value = value * 10 + (*c++ - '0');
+			return negative ? -value : value;
 		}
-		return true;
-	}
+	};
 
-	char *copy() {
-		char *string = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-		memcpy(string, start, length);
-		string[length] = '\0';
-		return string;
+	/* Leading whitespace and trailing carriage returns are not part of a line or value. */
+	AtlasToken trim(const char *start, const char *end) {
+		while (start < end && isSpace(*start))
+			start++;
+		while (end > start && end[-1] == '\r')
+			end--;
+		AtlasToken token = {start, end};
+		return token;
 	}
 
-	int toInt() {
-		return (int) strtol(start, &end, 10);
-	}
-};
-
-struct AtlasInput {
-	const char *start;
-	const char *end;
-	char *index;
-	int length;
-	SimpleString line;
-
-	AtlasInput(const char *data, int length) : start(data), end(data + length), index((char *) data), length(length) {}
-
-	SimpleString *readLine() {
-		if (index >= end) return 0;
-		line.start = index;
-		while (index < end && *index != '\n')
-			index++;
-		line.end = index;
-		if (index != end) index++;
-		line = line.trim();
-		line.length = (int) (end - start);
-		return &line;
-	}
+	class AtlasReader {
+	public:
+		AtlasReader(const char *data, int length) : _index(data), _end(data + length) {
+		}
 
-	static int readEntry(SimpleString entry[5], SimpleString *line) {
-		if (line == NULL) return 0;
-		line->trim();
-		if (line->length == 0) return 0;
-
-		int colon = line->indexOf(':');
-		if (colon == -1) return 0;
-		entry[0] = line->substr(0, colon).trim();
-		for (int i = 1, lastMatch = colon + 1;; i++) {
-			int comma = line->indexOf(',', lastMatch);
-			if (comma == -1) {
-				entry[i] = line->substr(lastMatch).trim();
-				return i;
+		/* Returns false and an empty line at the end of the data. */
+		bool readLine(AtlasToken &line) {
+			if (_index >= _end) {
+				line.start = line.end = _end;
+				return false;
 			}
-			entry[i] = line->substr(lastMatch, comma - lastMatch).trim();
-			lastMatch = comma + 1;
-			if (i == 4) return 4;
+			const char *lineEnd = (const char *) memchr(_index, '\n', _end - _index);
+			if (!lineEnd) lineEnd = _end;
+			line = trim(_index, lineEnd);
+			_index = lineEnd < _end ? lineEnd + 1 : _end;
+			return true;
 		}
-	}
-};
 
-int indexOf(const char **array, int count, SimpleString *str) {
-	for (int i = 0; i < count; i++)
-		if (str->equals(array[i])) return i;
-	return 0;
+		/* Splits a "key: value, value, ..." line in place, keeping at most 4 values. Values that are not present are
+		 * empty. Returns the number of values, or 0 if the line is not an entry. */
+		static int readEntry(AtlasToken entry[5], const AtlasToken &line) {
+			if (line.start == line.end) return 0;
+			const char *colon = (const char *) memchr(line.start, ':', line.length());
+			if (!colon) return 0;
+			entry[0] = trim(line.start, colon);
+			const char *value = colon + 1;
+			int count = 1;
+			for (;; count++) {
+				const char *comma = (const char *) memchr(value, ',', line.end - value);
+				if (!comma) {
+					entry[count] = trim(value, line.end);
+					break;
+				}
+				entry[count] = trim(value, comma);
+				if (count == 4) break;
+				value = comma + 1;
+			}
+			for (int i = count + 1; i < 5; i++)
+				entry[i].start = entry[i].end = line.end;
+			return count;
+		}
+
+	private:
+		const char *_index;
+		const char *_end;
+	};
+
+	int indexOf(const char **array, int count, const AtlasToken &token) {
+		for (int i = 0; i < count; i++)
+			if (token.equals(array[i], (int) strlen(array[i]))) return i;
+		return 0;
+	}
 }
 
 void Atlas::load(const char *begin, int length, const char *dir, bool createTexture) {
@@ -232,49 +221,43 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 
 	int dirLength = (int) strlen(dir);
 	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
-	AtlasInput reader(begin, length);
-	SimpleString entry[5];
+	AtlasReader reader(begin, length);
+	AtlasToken line, entry[5];
 	AtlasPage *page = NULL;
 
-	SimpleString *line = reader.readLine();
-	while (line != NULL && line->length == 0)
-		line = reader.readLine();
+	bool hasLine = reader.readLine(line);
+	while (hasLine && line.length() == 0)
+		hasLine = reader.readLine(line);
 
-	while (true) {
-		if (line == NULL || line->length == 0) break;
-		if (reader.readEntry(entry, line) == 0) break;
-		line = reader.readLine();
-	}
+	while (hasLine && AtlasReader::readEntry(entry, line) != 0)
+		hasLine = reader.readLine(line);
 
-	while (true) {
-		if (line == NULL) break;
-		if (line->trim().length == 0) {
+	while (hasLine) {
+		if (line.length() == 0) {
 			page = NULL;
-			line = reader.readLine();
+			hasLine = reader.readLine(line);
 		} else if (page == NULL) {
-			char *name = line->copy();
+			char *name = line.copy();
 			char *path = SpineExtension::calloc<char>(dirLength + needsSlash + strlen(name) + 1, __FILE__, __LINE__);
 			memcpy(path, dir, dirLength);
 			if (needsSlash) path[dirLength] = '/';
 			strcpy(path + dirLength + needsSlash, name);
 			page = new (__FILE__, __LINE__) AtlasPage(String(name, true));
 
-			while (true) {
-				line = reader.readLine();
-				if (reader.readEntry(entry, line) == 0) break;
+			while ((hasLine = reader.readLine(line)) && AtlasReader::readEntry(entry, line) != 0) {
 				if (entry[0].equals("size")) {
 					page->width = entry[1].toInt();
 					page->height = entry[2].toInt();
 				} else if (entry[0].equals("format")) {
-					page->format = (Format) indexOf(formatNames, 8, &entry[1]);
+					page->format = (Format) indexOf(formatNames, 8, entry[1]);
 				} else if (entry[0].equals("filter")) {
-					page->minFilter = (TEXTURE_FILTER_ENUM) indexOf(textureFilterNames, 8, &entry[1]);
-					page->magFilter = (TEXTURE_FILTER_ENUM) indexOf(textureFilterNames, 8, &entry[2]);
+					page->minFilter = (TEXTURE_FILTER_ENUM) indexOf(textureFilterNames, 8, entry[1]);
+					page->magFilter = (TEXTURE_FILTER_ENUM) indexOf(textureFilterNames, 8, entry[2]);
 				} else if (entry[0].equals("repeat")) {
 					page->uWrap = TextureWrap_ClampToEdge;
 					page->vWrap = TextureWrap_ClampToEdge;
-					if (entry[1].indexOf('x') != -1) page->uWrap = TextureWrap_Repeat;
-					if (entry[1].indexOf('y') != -1) page->vWrap = TextureWrap_Repeat;
+					if (entry[1].contains('x')) page->uWrap = TextureWrap_Repeat;
+					if (entry[1].contains('y')) page->vWrap = TextureWrap_Repeat;
 				} else if (entry[0].equals("pma")) {
 					page->pma = entry[1].equals("true");
 				}
@@ -288,11 +271,9 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			AtlasRegion *region = new (__FILE__, __LINE__) AtlasRegion();
 			region->page = page;
 			region->rendererObject = page->texture;
-			region->name = String(line->copy(), true);
-			while (true) {
-				line = reader.readLine();
-				int count = reader.readEntry(entry, line);
-				if (count == 0) break;
+			region->name.own(line.copy());
+			int count;
+			while ((hasLine = reader.readLine(line)) && (count = AtlasReader::readEntry(entry, line)) != 0) {
 				if (entry[0].equals("xy")) {
 					region->x = entry[1].toInt();
 					region->y = entry[2].toInt();
@@ -324,7 +305,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				} else if (entry[0].equals("index")) {
 					region->index = entry[1].toInt();
 				} else {
-					region->names.add(String(entry[0].copy()));
+					region->names.add(String(entry[0].copy(), true));
 					for (int i = 0; i < count; i++) {
 						region->values.add(entry[i + 1].toInt());
 					}
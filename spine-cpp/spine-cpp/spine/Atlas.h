@@ -35,6 +35,7 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <spine/HasRendererObject.h>
+#include <spine/NameIndex.h>
 #include "TextureRegion.h"
 
 namespace spine {
@@ -104,6 +105,8 @@ namespace spine {
 		Vector<int> pads;
 		Vector <String> names;
 		Vector<float> values;
+
+		const String &getName() { return name; }
 	};
 
 	class TextureLoader;
@@ -118,11 +121,16 @@ namespace spine {
 
 		void flipV();
 
-		/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-		/// should be cached rather than calling this method multiple times.
+		/// Returns the first region found with the specified name, using a hash index. If regions are added after
+		/// loading, call updateIndex() so lookups don't fall back to comparing each region's name.
 		/// @return The region, or NULL.
 		AtlasRegion *findRegion(const String &name);
 
+		/// @return The region, or NULL.
+		AtlasRegion *findRegion(const NameHash &name);
+
+		void updateIndex();
+
 		Vector<AtlasPage *> &getPages();
 
 		Vector<AtlasRegion *> &getRegions();
@@ -130,6 +138,7 @@ namespace spine {
 	private:
 		Vector<AtlasPage *> _pages;
 		Vector<AtlasRegion *> _regions;
+		NameIndex _regionIndex;
 		TextureLoader *_textureLoader;
 
 		void load(const char *begin, int length, const char *dir, bool createTexture);
@@ -46,23 +46,52 @@ namespace spine {
             return size - allocated;
         }
 
-        bool canFit(int numBytes) {
-            return free() >= numBytes;
+        /// The padding needed to align the next allocation, alignment being a power of two.
+        int padding(int alignment) {
+            return (int) ((alignment - ((uintptr_t) (memory + allocated) & (alignment - 1))) & (alignment - 1));
         }
 
-        uint8_t *allocate(int numBytes) {
+        bool canFit(int numBytes, int alignment = 16) {
+            return free() >= numBytes + padding(alignment);
+        }
+
+        uint8_t *allocate(int numBytes, int alignment = 16) {
+            allocated += padding(alignment);
             uint8_t *ptr = memory + allocated;
             allocated += numBytes;
             return ptr;
         }
     };
 
+    /// Hands out memory from large blocks. Memory is not freed individually; compress() makes all of it available
+    /// again, typically once per frame.
+    ///
+    /// When a frame needs more memory than the current block has, further blocks are added, each at least as large as
+    /// all blocks before it. compress() then replaces them with one block of their combined size, so the capacity follows
+    /// the high water mark with headroom and steady frames don't reach the heap. The block is only shrunk when the
+    /// frames of a whole period used less than a quarter of it.
     class BlockAllocator : public SpineObject {
-        int initialBlockSize;
-        Vector <Block> blocks;
-
     public:
-        BlockAllocator(int initialBlockSize) : initialBlockSize(initialBlockSize) {
+        struct Stats {
+            /// The number of blocks and their combined size in bytes.
+            int blocks;
+            size_t capacity;
+            /// The bytes allocated since the last compress(), including padding, and the most in any frame so far.
+            size_t bytesInUse;
+            size_t peakBytesInUse;
+            /// The number of blocks taken from the system since the last compress(), including a block that replaced
+            /// the previous ones in compress(), and in total.
+            int frameReallocations;
+            size_t reallocations;
+        };
+
+        BlockAllocator(int initialBlockSize) : initialBlockSize(initialBlockSize), periodPeak(0), periodFrames(0) {
+            stats.blocks = 0;
+            stats.capacity = 0;
+            stats.bytesInUse = 0;
+            stats.peakBytesInUse = 0;
+            stats.frameReallocations = 0;
+            stats.reallocations = 0;
             blocks.add(newBlock(initialBlockSize));
         }
 
@@ -72,40 +101,81 @@ namespace spine {
             }
         }
 
+        /// @param alignment A power of two. Allocations are aligned to at least 16 bytes.
         template<typename T>
-        T *allocate(size_t num) {
-            return (T *) _allocate((int) (sizeof(T) * num));
+        T *allocate(size_t num, int alignment = 16) {
+            return (T *) _allocate((int) (sizeof(T) * num), alignment);
         }
 
         void compress() {
+            size_t used = stats.bytesInUse;
+            if (used > periodPeak) periodPeak = used;
+            stats.bytesInUse = 0;
+            stats.frameReallocations = 0;
+
+            // Several blocks are merged into one of their combined size, which has grown geometrically.
+            int size = (int) stats.capacity;
             if (blocks.size() == 1) {
-                blocks[0].allocated = 0;
-                return;
+                bool shrink = false;
+                if (++periodFrames >= ShrinkPeriod) {
+                    shrink = periodPeak < stats.capacity >> 2 && size > initialBlockSize;
+                    size = (int) (periodPeak << 1);
+                    periodPeak = 0;
+                    periodFrames = 0;
+                }
+                if (!shrink) {
+                    blocks[0].allocated = 0;
+                    return;
+                }
             }
-            int totalSize = 0;
-            for (int i = 0, n = (int)blocks.size(); i < n; i++) {
-                totalSize += blocks[i].size;
+
+            for (int i = 0, n = (int) blocks.size(); i < n; i++) {
                 SpineExtension::free(blocks[i].memory, __FILE__, __LINE__);
             }
             blocks.clear();
-            blocks.add(newBlock(totalSize));
+            stats.blocks = 0;
+            stats.capacity = 0;
+            blocks.add(newBlock(size));
+        }
+
+        const Stats &getStats() {
+            return stats;
         }
 
     private:
-        void *_allocate(int numBytes) {
-            // 16-byte align allocations
+        /* The number of frames over which the peak usage must stay low before the block shrinks. */
+        static const int ShrinkPeriod = 256;
+
+        int initialBlockSize;
+        Vector <Block> blocks;
+        Stats stats;
+        size_t periodPeak;
+        int periodFrames;
+
+        void *_allocate(int numBytes, int alignment) {
+            if (alignment < 16) alignment = 16;
+            // Keep sizes a multiple of 16, so unaligned allocations don't need padding
             int alignedNumBytes = numBytes + (numBytes % 16 != 0 ? 16 - (numBytes % 16) : 0);
             Block *block = &blocks[blocks.size() - 1];
-            if (!block->canFit(alignedNumBytes)) {
-                blocks.add(newBlock(MathUtil::max(initialBlockSize, alignedNumBytes)));
+            int allocated = block->allocated;
+            if (!block->canFit(alignedNumBytes, alignment)) {
+                blocks.add(newBlock(MathUtil::max((int) stats.capacity, alignedNumBytes + alignment - 16)));
                 block = &blocks[blocks.size() - 1];
+                allocated = 0;
             }
-            return block->allocate(alignedNumBytes);
+            uint8_t *ptr = block->allocate(alignedNumBytes, alignment);
+            stats.bytesInUse += block->allocated - allocated;
+            if (stats.bytesInUse > stats.peakBytesInUse) stats.peakBytesInUse = stats.bytesInUse;
+            return ptr;
         }
 
         Block newBlock(int numBytes) {
             Block block = {MathUtil::max(initialBlockSize, numBytes), 0, nullptr};
             block.memory = SpineExtension::alloc<uint8_t>(block.size, __FILE__, __LINE__);
+            stats.blocks++;
+            stats.capacity += block.size;
+            stats.frameReallocations++;
+            stats.reallocations++;
             return block;
         }
     };
@@ -272,7 +272,7 @@ namespace spine {
 		BoneData &_data;
 		Skeleton &_skeleton;
 		Bone *_parent;
-		Vector<Bone *> _children;
+		InlineVector<Bone *, 4> _children;
 		float _x, _y, _rotation, _scaleX, _scaleY, _shearX, _shearY;
 		float _ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY;
 		float _a, _b, _worldX;
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/DataArena.h>
+#include <spine/Extension.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+using namespace spine;
+
+struct DataArena::Chunk {
+	Chunk *next;
+	DataArena *arena;
+	char *end;
+};
+
+namespace {
+	const size_t HeaderSize = (sizeof(void *) * 3 + 15) & ~(size_t) 15;
+	/* Each allocation is preceded by its size, so reallocating copies exactly the old size. The size is put in the
+	 * padding of the previous allocation where there is room, so allocations start at (16 - SizeHeader) mod 16 and
+	 * memory stays 16 byte aligned. */
+	const size_t SizeHeader = sizeof(size_t);
+	const size_t SizeOffset = 16 - SizeHeader;
+	const size_t MinChunkSize = 64 * 1024;
+	const size_t MaxChunkSize = 1024 * 1024;
+
+	struct Range {
+		char *start;
+		char *end;
+		void *chunk;
+	};
+
+	/* The chunks of all arenas at one time, sorted by address, so SpineExtension can tell arena memory from other
+	 * memory. A table is never changed once published. Adding or removing a chunk publishes a copy and retires the
+	 * old table, which is freed once no thread is searching. Tables are allocated with malloc, as SpineExtension
+	 * would route their memory to an arena. */
+	struct RangeTable {
+		RangeTable *retired;
+		size_t count;
+		Range ranges[1];
+	};
+
+	std::mutex rangesMutex;
+	std::atomic<RangeTable *> ranges(NULL);
+	RangeTable *retiredRanges = NULL;
+	std::atomic<int> rangeReaders(0);
+	std::atomic<uintptr_t> lowest(UINTPTR_MAX);
+	std::atomic<uintptr_t> highest(0);
+
+	/* The number of chunks overlapping each 64KB slab of addresses, hashed into a fixed table. Freeing memory outside
+	 * of arenas usually finds its slab empty with a single relaxed load, without counting itself as a reader of the
+	 * range table. Chunks are counted before they are published and uncounted after they are removed. */
+	const int SlabShift = 16;
+	const size_t SlabCount = 4096;
+	std::atomic<int> slabChunks[SlabCount];
+
+	thread_local DataArena::Scope *currentScope = NULL;
+
+	/* The bytes taken by an allocation of the given size, including its size header. */
+	inline size_t align(size_t size) {
+		return (size + SizeHeader + 15) & ~(size_t) 15;
+	}
+
+	inline size_t &sizeOf(void *ptr) {
+		return *(size_t *) ((char *) ptr - SizeHeader);
+	}
+
+	void countSlabs(char *start, char *end, int count) {
+		uintptr_t last = (uintptr_t) (end - 1) >> SlabShift;
+		for (uintptr_t slab = (uintptr_t) start >> SlabShift; slab <= last; slab++)
+			slabChunks[slab & (SlabCount - 1)].fetch_add(count, std::memory_order_relaxed);
+	}
+
+	RangeTable *newRangeTable(size_t count) {
+		RangeTable *table = (RangeTable *) ::malloc(sizeof(RangeTable) + (count ? count - 1 : 0) * sizeof(Range));
+		table->retired = NULL;
+		table->count = count;
+		return table;
+	}
+
+	/* Called with rangesMutex locked. */
+	void publishRanges(RangeTable *table) {
+		RangeTable *old = ranges.load(std::memory_order_relaxed);
+		lowest.store(table ? (uintptr_t) table->ranges[0].start : UINTPTR_MAX, std::memory_order_relaxed);
+		highest.store(table ? (uintptr_t) table->ranges[table->count - 1].end : 0, std::memory_order_relaxed);
+		ranges.store(table, std::memory_order_seq_cst);
+		if (old) {
+			old->retired = retiredRanges;
+			retiredRanges = old;
+		}
+		/* A reader counts itself before loading the table. If none is counted after the new table is published, no
+		 * reader can still be searching a retired one. */
+		if (rangeReaders.load(std::memory_order_seq_cst)) return;
+		for (RangeTable *retired = retiredRanges, *next; retired; retired = next) {
+			next = retired->retired;
+			::free(retired);
+		}
+		retiredRanges = NULL;
+	}
+}
+
+DataArena::Scope::Scope(DataArena *arena) : _arena(arena), _previous(currentScope) {
+	if (arena) SpineExtension::_arenaScopes.fetch_add(1, std::memory_order_relaxed);
+	currentScope = this;
+}
+
+DataArena::Scope::~Scope() {
+	if (_arena) SpineExtension::_arenaScopes.fetch_sub(1, std::memory_order_relaxed);
+	currentScope = _previous;
+}
+
+DataArena::DataArena() : _chunks(NULL), _current(NULL), _cursor(NULL), _end(NULL), _last(NULL), _capacity(0), _used(0) {
+}
+
+DataArena::~DataArena() {
+	/* Loaders delete skeleton data they failed to read only after the scope installing its arena has ended. */
+	for (Scope *scope = currentScope; scope; scope = scope->_previous)
+		assert(scope->_arena != this);
+	if (!_chunks) return;
+
+	int count = 0;
+	{
+		std::lock_guard<std::mutex> lock(rangesMutex);
+		RangeTable *table = ranges.load(std::memory_order_relaxed);
+		RangeTable *kept = NULL;
+		for (size_t i = 0; i < table->count; i++) {
+			if (((Chunk *) table->ranges[i].chunk)->arena == this) count++;
+		}
+		if (count < (int) table->count) {
+			kept = newRangeTable(table->count - count);
+			size_t index = 0;
+			for (size_t i = 0; i < table->count; i++) {
+				if (((Chunk *) table->ranges[i].chunk)->arena != this) kept->ranges[index++] = table->ranges[i];
+			}
+		}
+		publishRanges(kept);
+	}
+	SpineExtension::_arenaChunks.fetch_sub(count, std::memory_order_relaxed);
+
+	for (Chunk *chunk = _chunks, *next; chunk; chunk = next) {
+		next = chunk->next;
+		countSlabs((char *) chunk + HeaderSize, chunk->end, -1);
+		SpineExtension::getInstance()->_free(chunk, __FILE__, __LINE__);
+	}
+}
+
+size_t DataArena::getCapacity() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _capacity;
+}
+
+size_t DataArena::getUsed() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _used;
+}
+
+DataArena *DataArena::getCurrent() {
+	return currentScope ? currentScope->_arena : NULL;
+}
+
+void *DataArena::allocate(size_t size) {
+	size_t aligned = align(size);
+	char *ptr;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_used += aligned;
+		if (aligned > (size_t) (_end - _cursor)) {
+			size_t chunkSize = _capacity < MinChunkSize ? MinChunkSize : (_capacity > MaxChunkSize ? MaxChunkSize : _capacity);
+			if (aligned > chunkSize >> 2) {
+				/* Large allocations get a chunk of their own, so the current chunk's space isn't wasted. */
+				Chunk *chunk = addChunk(SizeOffset + aligned);
+				ptr = (char *) chunk + HeaderSize + SizeOffset + SizeHeader;
+				sizeOf(ptr) = size;
+				return ptr;
+			}
+			_current = addChunk(SizeOffset + chunkSize);
+			_cursor = (char *) _current + HeaderSize + SizeOffset;
+			_end = _current->end;
+		}
+		ptr = _last = _cursor + SizeHeader;
+		_cursor += aligned;
+	}
+	sizeOf(ptr) = size;
+	return ptr;
+}
+
+void *DataArena::reallocate(void *ptr, size_t size) {
+	size_t oldSize = sizeOf(ptr);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (ptr == _last && align(size) <= (size_t) (_end - (_last - SizeHeader))) {
+			/* The most recent allocation grows in place. */
+			char *cursor = _last - SizeHeader + align(size);
+			_used += cursor - _cursor;
+			_cursor = cursor;
+			sizeOf(ptr) = size;
+			return ptr;
+		}
+	}
+	DataArena *arena = getCurrent();
+	void *result = arena ? arena->allocate(size) : SpineExtension::getInstance()->_alloc(size, __FILE__, __LINE__);
+	memcpy(result, ptr, size < oldSize ? size : oldSize);
+	return result;
+}
+
+void DataArena::release(void *ptr) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (ptr != _last) return;
+	_used -= _cursor - (_last - SizeHeader);
+	_cursor = _last - SizeHeader;
+	_last = NULL;
+}
+
+DataArena::Chunk *DataArena::addChunk(size_t size) {
+	Chunk *chunk = (Chunk *) SpineExtension::getInstance()->_alloc(HeaderSize + size, __FILE__, __LINE__);
+	chunk->arena = this;
+	chunk->end = (char *) chunk + HeaderSize + size;
+	chunk->next = _chunks;
+	_chunks = chunk;
+	_capacity += size;
+	countSlabs((char *) chunk + HeaderSize, chunk->end, 1);
+
+	std::lock_guard<std::mutex> lock(rangesMutex);
+	RangeTable *table = ranges.load(std::memory_order_relaxed);
+	size_t count = table ? table->count : 0;
+	RangeTable *added = newRangeTable(count + 1);
+	size_t index = count;
+	while (index > 0 && table->ranges[index - 1].start > (char *) chunk) index--;
+	if (index) memcpy(added->ranges, table->ranges, index * sizeof(Range));
+	if (index < count) memcpy(added->ranges + index + 1, table->ranges + index, (count - index) * sizeof(Range));
+	added->ranges[index].start = (char *) chunk + HeaderSize;
+	added->ranges[index].end = chunk->end;
+	added->ranges[index].chunk = chunk;
+	publishRanges(added);
+	SpineExtension::_arenaChunks.fetch_add(1, std::memory_order_relaxed);
+	return chunk;
+}
+
+DataArena::Chunk *DataArena::findChunk(void *ptr) {
+	uintptr_t address = (uintptr_t) ptr;
+	if (address < lowest.load(std::memory_order_relaxed) || address >= highest.load(std::memory_order_relaxed))
+		return NULL;
+	if (!slabChunks[(address >> SlabShift) & (SlabCount - 1)].load(std::memory_order_relaxed)) return NULL;
+	rangeReaders.fetch_add(1, std::memory_order_seq_cst);
+	RangeTable *table = ranges.load(std::memory_order_seq_cst);
+	Chunk *chunk = NULL;
+	if (table) {
+		size_t low = 0, high = table->count;
+		while (low < high) {
+			size_t middle = (low + high) >> 1;
+			if (table->ranges[middle].end <= (char *) ptr)
+				low = middle + 1;
+			else
+				high = middle;
+		}
+		if (low < table->count && table->ranges[low].start <= (char *) ptr) chunk = (Chunk *) table->ranges[low].chunk;
+	}
+	rangeReaders.fetch_sub(1, std::memory_order_release);
+	return chunk;
+}
+
+void *SpineExtension::arenaAlloc(size_t size, bool clear, const char *file, int line) {
+	DataArena *arena = DataArena::getCurrent();
+	if (!arena) return clear ? getInstance()->_calloc(size, file, line) : getInstance()->_alloc(size, file, line);
+	void *ptr = arena->allocate(size);
+	if (clear) memset(ptr, 0, size);
+	return ptr;
+}
+
+void *SpineExtension::arenaRealloc(void *ptr, size_t size, const char *file, int line) {
+	if (!ptr) return arenaAlloc(size, false, file, line);
+	DataArena::Chunk *chunk = DataArena::findChunk(ptr);
+	if (chunk) return chunk->arena->reallocate(ptr, size);
+	return getInstance()->_realloc(ptr, size, file, line);
+}
+
+bool SpineExtension::arenaFree(void *ptr) {
+	DataArena::Chunk *chunk = DataArena::findChunk(ptr);
+	if (!chunk) return false;
+	chunk->arena->release(ptr);
+	return true;
+}
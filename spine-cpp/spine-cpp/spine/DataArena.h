@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_DataArena_h
+#define Spine_DataArena_h
+
+#include <spine/SpineObject.h>
+
+#include <mutex>
+
+namespace spine {
+	/// Long lived memory for loaded skeleton data. While an arena is installed on a thread with DataArena::Scope, all
+	/// memory allocated through SpineExtension on that thread comes from the arena's chunks. Freeing arena memory does
+	/// nothing, except that the most recent allocation is given back, and all chunks are released at once when the arena
+	/// is destroyed.
+	///
+	/// SkeletonJson and SkeletonBinary use the SkeletonData's arena when SkeletonJson::setUseArena() or
+	/// SkeletonBinary::setUseArena() is enabled. Arena memory may be freed or reallocated through SpineExtension at any
+	/// time, also when no arena is installed, so objects in an arena can be modified like others. Finding the chunk of
+	/// such memory doesn't take a lock, and freeing other memory while arenas exist usually costs one more load.
+	class SP_API DataArena : public SpineObject {
+		friend class SpineExtension;
+
+	public:
+		/// Installs an arena on the calling thread until the scope ends. Scopes can be nested. A scope with a NULL arena
+		/// makes the calling thread allocate from SpineExtension again, e.g. for temporary data. An arena must not be
+		/// destroyed while a scope installs it.
+		class SP_API Scope {
+			friend class DataArena;
+
+		public:
+			explicit Scope(DataArena *arena);
+
+			~Scope();
+
+		private:
+			DataArena *_arena;
+			Scope *_previous;
+		};
+
+		DataArena();
+
+		/// Releases all chunks. Memory from the arena becomes invalid.
+		~DataArena();
+
+		/// The bytes taken from SpineExtension for chunks.
+		size_t getCapacity();
+
+		/// The bytes handed out and not given back, including padding and the size kept before each allocation.
+		size_t getUsed();
+
+		/// The arena installed on the calling thread, or NULL.
+		static DataArena *getCurrent();
+
+	private:
+		struct Chunk;
+
+		std::mutex _mutex;
+		Chunk *_chunks;
+		Chunk *_current;
+		char *_cursor;
+		char *_end;
+		char *_last;
+		size_t _capacity;
+		size_t _used;
+
+		void *allocate(size_t size);
+
+		void *reallocate(void *ptr, size_t size);
+
+		void release(void *ptr);
+
+		Chunk *addChunk(size_t size);
+
+		static Chunk *findChunk(void *ptr);
+	};
+}
+
+#endif /* Spine_DataArena_h */
@@ -31,11 +31,31 @@
 #include <spine/SpineString.h>
 
 #include <assert.h>
+#include <limits.h>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
 
+std::atomic<int> SpineExtension::_arenaScopes(0);
+
+std::atomic<int> SpineExtension::_arenaChunks(0);
+
 void SpineExtension::setInstance(SpineExtension *inValue) {
 	assert(inValue);
 
@@ -55,6 +75,24 @@ SpineExtension::~SpineExtension() {
 SpineExtension::SpineExtension() {
 }
 
+bool SpineExtension::_mapFile(const String &path, MappedFile &file) {
+	int length = 0;
+	char *data = _readFile(path, &length);
+	if (!data) return false;
+
+	data = SpineExtension::realloc(data, length + 1, __FILE__, __LINE__);
+	data[length] = '\0';
+	file.data = data;
+	file.length = length;
+	file.handle = NULL;
+	return true;
+}
+
+void SpineExtension::_unmapFile(MappedFile &file) {
+	if (file.data) SpineExtension::free(file.data, __FILE__, __LINE__);
+	file = MappedFile();
+}
+
 DefaultSpineExtension::~DefaultSpineExtension() {
 }
 
@@ -123,5 +161,67 @@ char *DefaultSpineExtension::_readFile(const String &path, int *length) {
 #endif
 }
 
+bool DefaultSpineExtension::_mapFile(const String &path, MappedFile &file) {
+	/* Files ending exactly on a page boundary are read instead, since the zero-filled tail of the last
+	 * page is what terminates the mapped data. */
+#if defined(_WIN32)
+	HANDLE fileHandle = CreateFileA(path.buffer(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+									FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle != INVALID_HANDLE_VALUE) {
+		LARGE_INTEGER size;
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		if (GetFileSizeEx(fileHandle, &size) && size.QuadPart > 0 && size.QuadPart < INT_MAX &&
+			size.QuadPart % info.dwPageSize != 0) {
+			HANDLE mapping = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping) {
+				void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+				if (view) {
+					CloseHandle(fileHandle);
+					file.data = (const char *) view;
+					file.length = (int) size.QuadPart;
+					file.handle = view;
+					return true;
+				}
+			}
+		}
+		CloseHandle(fileHandle);
+	}
+#elif !defined(__EMSCRIPTEN__)
+	int fd = open(path.buffer(), O_RDONLY);
+	if (fd != -1) {
+		struct stat info;
+		long pageSize = sysconf(_SC_PAGESIZE);
+		if (fstat(fd, &info) == 0 && info.st_size > 0 && info.st_size < INT_MAX && pageSize > 0 &&
+			info.st_size % pageSize != 0) {
+			void *view = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (view != MAP_FAILED) {
+				close(fd);
+				file.data = (const char *) view;
+				file.length = (int) info.st_size;
+				file.handle = view;
+				return true;
+			}
+		}
+		close(fd);
+	}
+#endif
+	return SpineExtension::_mapFile(path, file);
+}
+
+void DefaultSpineExtension::_unmapFile(MappedFile &file) {
+	if (!file.handle) {
+		SpineExtension::_unmapFile(file);
+		return;
+	}
+#if defined(_WIN32)
+	UnmapViewOfFile(file.handle);
+#elif !defined(__EMSCRIPTEN__)
+	munmap(file.handle, (size_t) file.length);
+#endif
+	file = MappedFile();
+}
+
 DefaultSpineExtension::DefaultSpineExtension() : SpineExtension() {
 }
@@ -34,30 +34,52 @@
 #include <stdlib.h>
 #include <spine/dll.h>
 
+#include <atomic>
+
 #define SP_UNUSED(x) (void)(x)
 
 namespace spine {
 	class String;
 
+	/// A read-only view of a file's contents, returned by SpineExtension::mapFile(). The data is always followed
+	/// by a zero byte, so text formats can be parsed in place.
+	struct SP_API MappedFile {
+		const char *data;
+		int length;
+		/// Implementation specific, NULL if the contents were read into a buffer allocated by the extension.
+		void *handle;
+
+		MappedFile() : data(NULL), length(0), handle(NULL) {}
+	};
+
+	class DataArena;
+
 	class SP_API SpineExtension {
+		friend class DataArena;
+
 	public:
 		template<typename T>
 		static T *alloc(size_t num, const char *file, int line) {
+			if (_arenaScopes.load(std::memory_order_relaxed)) return (T *) arenaAlloc(sizeof(T) * num, false, file, line);
 			return (T *) getInstance()->_alloc(sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static T *calloc(size_t num, const char *file, int line) {
+			if (_arenaScopes.load(std::memory_order_relaxed)) return (T *) arenaAlloc(sizeof(T) * num, true, file, line);
 			return (T *) getInstance()->_calloc(sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static T *realloc(T *ptr, size_t num, const char *file, int line) {
+			if (_arenaScopes.load(std::memory_order_relaxed) || _arenaChunks.load(std::memory_order_relaxed))
+				return (T *) arenaRealloc((void *) ptr, sizeof(T) * num, file, line);
 			return (T *) getInstance()->_realloc(ptr, sizeof(T) * num, file, line);
 		}
 
 		template<typename T>
 		static void free(T *ptr, const char *file, int line) {
+			if (_arenaChunks.load(std::memory_order_relaxed) && arenaFree((void *) ptr)) return;
 			getInstance()->_free((void *) ptr, file, line);
 		}
 
@@ -70,6 +92,16 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		/// Maps the file into memory if the platform supports it, otherwise reads it into an allocated buffer.
+		/// Returns false if the file could not be read. Release the file with unmapFile().
+		static bool mapFile(const String &path, MappedFile &file) {
+			return getInstance()->_mapFile(path, file);
+		}
+
+		static void unmapFile(MappedFile &file) {
+			getInstance()->_unmapFile(file);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -88,6 +120,11 @@ namespace spine {
 
 		virtual char *_readFile(const String &path, int *length) = 0;
 
+		/// Override to map files with your engine's file system. The default reads the file with _readFile().
+		virtual bool _mapFile(const String &path, MappedFile &file);
+
+		virtual void _unmapFile(MappedFile &file);
+
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
 	protected:
@@ -95,6 +132,16 @@ namespace spine {
 
 	private:
 		static SpineExtension *_instance;
+		/* The number of DataArena scopes with an arena on any thread, and of chunks in all arenas. While both are 0,
+		 * memory goes straight to the instance. */
+		static std::atomic<int> _arenaScopes;
+		static std::atomic<int> _arenaChunks;
+
+		static void *arenaAlloc(size_t size, bool clear, const char *file, int line);
+
+		static void *arenaRealloc(void *ptr, size_t size, const char *file, int line);
+
+		static bool arenaFree(void *ptr);
 	};
 
 	class SP_API DefaultSpineExtension : public SpineExtension {
@@ -113,6 +160,10 @@ namespace spine {
 		virtual void _free(void *mem, const char *file, int line) override;
 
 		virtual char *_readFile(const String &path, int *length) override;
+
+		virtual bool _mapFile(const String &path, MappedFile &file) override;
+
+		virtual void _unmapFile(MappedFile &file) override;
 	};
 
 // This function is to be implemented by engine specific runtimes to provide
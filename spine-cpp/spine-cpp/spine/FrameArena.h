@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_FrameArena_h
+#define Spine_FrameArena_h
+
+#include <spine/BlockAllocator.h>
+#include <spine/SpineObject.h>
+#include <spine/Vector.h>
+
+namespace spine {
+	/// Scratch memory for data that is only needed during a single update, apply or render call. While an arena is
+	/// installed on a thread with FrameArena::Scope, AnimationState takes the property ID set it builds when animations
+	/// change from it, and a SkeletonRenderer with setUseFrameArena() its render commands. Other per frame data lives
+	/// in buffers each instance keeps, which stop growing once every animation has been played. Call reset() once per
+	/// frame, after all skeletons using the arena have been updated and rendered.
+	class SP_API FrameArena : public SpineObject {
+	public:
+		/// Installs an arena on the calling thread until the scope ends. Scopes can be nested.
+		class SP_API Scope {
+		public:
+			explicit Scope(FrameArena &arena);
+
+			~Scope();
+
+		private:
+			FrameArena *_previous;
+		};
+
+		explicit FrameArena(int initialSize = 64 * 1024);
+
+		~FrameArena();
+
+		template<typename T>
+		T *allocate(size_t num) {
+			return _allocator.allocate<T>(num);
+		}
+
+		/// Makes all memory available again. This takes constant time, unless the arena ran out of space since the
+		/// last reset. Then its blocks are merged into one large enough for the whole frame.
+		void reset();
+
+		BlockAllocator &getAllocator() {
+			return _allocator;
+		}
+
+		/// The arena installed on the calling thread, or NULL.
+		static FrameArena *getCurrent();
+
+		/// Returns num elements from the calling thread's arena, or if there is none, the buffer of the fallback
+		/// vector resized to num. The elements are not initialized.
+		template<typename T>
+		static T *allocate(Vector<T> &fallback, size_t num) {
+			FrameArena *arena = getCurrent();
+			if (arena) return arena->allocate<T>(num);
+			fallback.setSize(num, T());
+			return fallback.buffer();
+		}
+
+	private:
+		BlockAllocator _allocator;
+	};
+}
+
+#endif /* Spine_FrameArena_h */
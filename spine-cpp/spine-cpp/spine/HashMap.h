@@ -33,6 +33,11 @@
 #include <spine/Vector.h>
 #include <spine/SpineObject.h>
 
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
 // Required for new with line number and file name in MSVC
 #ifdef _MSC_VER
 #pragma warning(disable:4291)
@@ -42,6 +47,40 @@
 #endif
 
 namespace spine {
+	/// Hashes HashMap keys. Numbers, enums and pointers are hashed by value and Strings by their characters. Other key
+	/// types must have a size_t hashCode() const method that is consistent with their == operator.
+	template<typename K, bool Scalar = std::is_scalar<K>::value>
+	struct HashMapKey {
+		static size_t hashCode(const K &key) {
+			return key.hashCode();
+		}
+	};
+
+	template<typename K>
+	struct HashMapKey<K, true> {
+		static size_t hashCode(const K &key) {
+			uint64_t bits = 0;
+			memcpy(&bits, &key, sizeof(K) < sizeof(bits) ? sizeof(K) : sizeof(bits));
+			/* Folds the high half in, so 64-bit keys that differ only there don't collide when size_t is 32 bits. */
+			return (size_t) (bits ^ (bits >> 32));
+		}
+	};
+
+	template<>
+	struct HashMapKey<String, false> {
+		static size_t hashCode(const String &key) {
+			uint64_t hash = 14695981039346656037ULL;
+			const char *chars = key.buffer();
+			for (size_t i = 0, n = key.length(); i < n; i++) {
+				hash ^= (unsigned char) chars[i];
+				hash *= 1099511628211ULL;
+			}
+			return (size_t) (hash ^ (hash >> 32));
+		}
+	};
+
+	/// A hash map with open addressing. Entries are stored in one array and placed with Robin Hood hashing, so lookups
+	/// probe few entries and never allocate.
 	template<typename K, typename V>
 	class SP_API HashMap : public SpineObject {
 	private:
@@ -60,47 +99,57 @@ namespace spine {
 		public:
 			friend class HashMap;
 
-			explicit Entries(Entry *entry) : _entry(NULL), _hasChecked(false) {
-				_start.next = entry;
-				_entry = &_start;
-			}
-
 			Pair next() {
-				assert(_entry);
 				assert(_hasChecked);
-				_entry = _entry->next;
-				Pair pair(_entry->_key, _entry->_value);
+				Entry &entry = _map->_entries[_index++];
+				Pair pair(entry._key, entry._value);
 				_hasChecked = false;
 				return pair;
 			}
 
 			bool hasNext() {
 				_hasChecked = true;
-				return _entry->next;
+				while (_index < _map->_capacity && !_map->_hashes[_index])
+					_index++;
+				return _index < _map->_capacity;
 			}
 
 		private:
+			explicit Entries(const HashMap *map) : _map(map), _index(0), _hasChecked(false) {
+			}
+
+			const HashMap *_map;
+			size_t _index;
 			bool _hasChecked;
-			Entry _start;
-			Entry *_entry;
 		};
 
 		HashMap() :
-				_head(NULL),
+				_hashes(NULL),
+				_entries(NULL),
+				_capacity(0),
 				_size(0) {
 		}
 
+		HashMap(const HashMap &) = delete;
+
+		HashMap &operator=(const HashMap &) = delete;
+
 		~HashMap() {
 			clear();
+			if (_hashes) {
+				SpineExtension::free(_hashes, __FILE__, __LINE__);
+				SpineExtension::free(_entries, __FILE__, __LINE__);
+			}
 		}
 
+		/// Removes all entries. The memory is kept for new entries.
 		void clear() {
-			for (Entry *entry = _head; entry != NULL;) {
-				Entry *next = entry->next;
-				delete entry;
-				entry = next;
+			if (_size == 0) return;
+			if (!std::is_trivially_destructible<Entry>::value) {
+				for (size_t i = 0; i < _capacity; i++)
+					if (_hashes[i]) _entries[i].~Entry();
 			}
-			_head = NULL;
+			memset(_hashes, 0, _capacity * sizeof(unsigned int));
 			_size = 0;
 		}
 
@@ -108,27 +157,24 @@ namespace spine {
 			return _size;
 		}
 
+		/// Makes room for the given number of entries, so adding them doesn't rehash.
+		void ensureCapacity(size_t size) {
+			size_t capacity = _capacity ? _capacity : 8;
+			while (size * 4 > capacity * 3)
+				capacity <<= 1;
+			if (capacity > _capacity) rehash(capacity);
+		}
+
 		void put(const K &key, const V &value) {
-			Entry *entry = find(key);
-			if (entry) {
-				entry->_key = key;
-				entry->_value = value;
-			} else {
-				entry = new(__FILE__, __LINE__) Entry();
-				entry->_key = key;
-				entry->_value = value;
-
-				Entry *oldHead = _head;
-
-				if (oldHead) {
-					_head = entry;
-					oldHead->prev = entry;
-					entry->next = oldHead;
-				} else {
-					_head = entry;
-				}
-				_size++;
+			unsigned int hash = hashOf(key);
+			size_t index = find(key, hash);
+			if (index != NotFound) {
+				_entries[index]._key = key;
+				_entries[index]._value = value;
+				return;
 			}
+			ensureCapacity(_size + 1);
+			insert(hash, K(key), V(value));
 		}
 
 		bool addAll(Vector <K> &keys, const V &value) {
@@ -140,29 +186,32 @@ namespace spine {
 		}
 
 		bool containsKey(const K &key) {
-			return find(key) != NULL;
+			return find(key, hashOf(key)) != NotFound;
 		}
 
 		bool remove(const K &key) {
-			Entry *entry = find(key);
-			if (!entry) return false;
-
-			Entry *prev = entry->prev;
-			Entry *next = entry->next;
-
-			if (prev) prev->next = next;
-			else _head = next;
-			if (next) next->prev = entry->prev;
-
-			delete entry;
+			size_t index = find(key, hashOf(key));
+			if (index == NotFound) return false;
+
+			/* Move the following entries of the run back, so no entry is further from its home slot than needed. */
+			size_t mask = _capacity - 1;
+			_entries[index].~Entry();
+			for (size_t next = (index + 1) & mask; _hashes[next] && ((next - _hashes[next]) & mask) != 0;
+				 next = (next + 1) & mask) {
+				new(_entries + index) Entry(std::move(_entries[next]));
+				_entries[next].~Entry();
+				_hashes[index] = _hashes[next];
+				index = next;
+			}
+			_hashes[index] = 0;
 			_size--;
 
 			return true;
 		}
 
 		V operator[](const K &key) {
-			Entry *entry = find(key);
-			if (entry) return entry->_value;
+			size_t index = find(key, hashOf(key));
+			if (index != NotFound) return _entries[index]._value;
 			else {
 				assert(false);
 				return 0;
@@ -170,29 +219,80 @@ namespace spine {
 		}
 
 		Entries getEntries() const {
-			return Entries(_head);
+			return Entries(this);
 		}
 
 	private:
-		Entry *find(const K &key) {
-			for (Entry *entry = _head; entry != NULL; entry = entry->next) {
-				if (entry->_key == key)
-					return entry;
-			}
-			return NULL;
-		}
+		static const size_t NotFound = (size_t) -1;
 
-		class SP_API Entry : public SpineObject {
+		class SP_API Entry {
 		public:
 			K _key;
 			V _value;
-			Entry *next;
-			Entry *prev;
 
-			Entry() : next(NULL), prev(NULL) {}
+			Entry(K &&key, V &&value) : _key(std::move(key)), _value(std::move(value)) {}
 		};
 
-		Entry *_head;
+		/* 0 marks an empty slot. */
+		static unsigned int hashOf(const K &key) {
+			unsigned int hash = (unsigned int) (((uint64_t) HashMapKey<K>::hashCode(key) * 0x9E3779B97F4A7C15ULL) >> 32);
+			return hash ? hash : 1;
+		}
+
+		size_t find(const K &key, unsigned int hash) {
+			if (_size == 0) return NotFound;
+			size_t mask = _capacity - 1;
+			for (size_t index = hash & mask, distance = 0;; index = (index + 1) & mask, distance++) {
+				unsigned int other = _hashes[index];
+				/* Entries are ordered by distance from their home slot, so a closer one ends the search. */
+				if (!other || ((index - other) & mask) < distance) return NotFound;
+				if (other == hash && _entries[index]._key == key) return index;
+			}
+		}
+
+		void insert(unsigned int hash, K &&key, V &&value) {
+			size_t mask = _capacity - 1;
+			for (size_t index = hash & mask, distance = 0;; index = (index + 1) & mask, distance++) {
+				unsigned int other = _hashes[index];
+				if (!other) {
+					new(_entries + index) Entry(std::move(key), std::move(value));
+					_hashes[index] = hash;
+					_size++;
+					return;
+				}
+				/* Take the slot of an entry that is closer to its home slot and move that entry on instead. */
+				size_t otherDistance = (index - other) & mask;
+				if (otherDistance < distance) {
+					std::swap(_hashes[index], hash);
+					std::swap(_entries[index]._key, key);
+					std::swap(_entries[index]._value, value);
+					distance = otherDistance;
+				}
+			}
+		}
+
+		void rehash(size_t capacity) {
+			unsigned int *hashes = _hashes;
+			Entry *entries = _entries;
+			size_t oldCapacity = _capacity;
+			_hashes = SpineExtension::calloc<unsigned int>(capacity, __FILE__, __LINE__);
+			_entries = (Entry *) SpineExtension::alloc<char>(capacity * sizeof(Entry), __FILE__, __LINE__);
+			_capacity = capacity;
+			_size = 0;
+			for (size_t i = 0; i < oldCapacity; i++) {
+				if (!hashes[i]) continue;
+				insert(hashes[i], std::move(entries[i]._key), std::move(entries[i]._value));
+				entries[i].~Entry();
+			}
+			if (hashes) {
+				SpineExtension::free(hashes, __FILE__, __LINE__);
+				SpineExtension::free(entries, __FILE__, __LINE__);
+			}
+		}
+
+		unsigned int *_hashes;
+		Entry *_entries;
+		size_t _capacity;
 		size_t _size;
 	};
 }
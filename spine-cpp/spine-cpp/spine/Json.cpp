@@ -37,9 +37,11 @@ THE SOFTWARE.
 #include <spine/Json.h>
 #include <spine/Extension.h>
 #include <spine/SpineString.h>
+#include <spine/Vector.h>
 
 #include <assert.h>
 #include <math.h>
+#include <stdint.h>
 
 using namespace spine;
 
@@ -51,11 +53,103 @@ const int Json::JSON_STRING = 4;
 const int Json::JSON_ARRAY = 5;
 const int Json::JSON_OBJECT = 6;
 
-const char *Json::_error = NULL;
+/* Per thread, so skeletons can be parsed on several threads at once. */
+static thread_local const char *parseError = NULL;
+
+/* Nodes, member indexes and strings are allocated in blocks that double in size, so a document needs few
+ * allocations and the nodes of an object or array are mostly contiguous. The text is only read while parsing:
+ * strings are unescaped into the blocks, and each distinct string is stored once, as skeleton exports repeat the
+ * same few names and values many times. */
+struct Json::Arena : public SpineObject {
+	struct Interned {
+		unsigned int hash;
+		unsigned int length;
+		const char *string;
+	};
+
+	Vector<char *> blocks;
+	char *cursor, *end;
+	size_t blockSize;
+	Vector<Interned> strings;
+	size_t stringCount;
+	Vector<char> scratch;
+
+	explicit Arena(size_t length) : cursor(NULL), end(NULL), stringCount(0) {
+		/* Roughly one value per 16 bytes of text in skeleton exports. */
+		blockSize = (length / 16 + 16) * sizeof(Json);
+		strings.setSize(256, Interned());
+	}
+
+	~Arena() {
+		for (size_t i = 0; i < blocks.size(); i++)
+			SpineExtension::free(blocks[i], __FILE__, __LINE__);
+	}
+
+	void *allocate(size_t size, size_t alignment) {
+		char *ptr = (char *) (((uintptr_t) cursor + alignment - 1) & ~(uintptr_t) (alignment - 1));
+		if (!cursor || size > (size_t) (end - ptr)) {
+			if (blocks.size()) blockSize <<= 1;
+			if (blockSize < size) blockSize = size;
+			ptr = SpineExtension::alloc<char>(blockSize, __FILE__, __LINE__);
+			blocks.add(ptr);
+			end = ptr + blockSize;
+		}
+		cursor = ptr + size;
+		return ptr;
+	}
+
+	Json *newNode() {
+		return new (allocate(sizeof(Json), sizeof(void *))) Json();
+	}
+
+	const char *intern(const char *string, size_t length) {
+		unsigned int hash = 2166136261u;
+		for (size_t i = 0; i < length; i++)
+			hash = (hash ^ (unsigned char) string[i]) * 16777619u;
+		size_t mask = strings.size() - 1;
+		for (size_t i = hash & mask;; i = (i + 1) & mask) {
+			Interned &entry = strings[i];
+			if (!entry.string) {
+				char *copy = (char *) allocate(length + 1, 1);
+				memcpy(copy, string, length);
+				copy[length] = '\0';
+				entry.hash = hash;
+				entry.length = (unsigned int) length;
+				entry.string = copy;
+				if (++stringCount * 2 > strings.size()) rehash();
+				return copy;
+			}
+			if (entry.hash == hash && entry.length == length && !memcmp(entry.string, string, length))
+				return entry.string;
+		}
+	}
+
+	void rehash() {
+		Vector<Interned> old;
+		old.setSize(strings.size(), Interned());
+		for (size_t i = 0; i < old.size(); i++) old[i] = strings[i];
+		strings.clear();
+		strings.setSize(old.size() * 2, Interned());
+		size_t mask = strings.size() - 1;
+		for (size_t i = 0; i < old.size(); i++) {
+			if (!old[i].string) continue;
+			size_t ii = old[i].hash & mask;
+			while (strings[ii].string) ii = (ii + 1) & mask;
+			strings[ii] = old[i];
+		}
+	}
+};
 
 Json *Json::getItem(Json *object, const char *string) {
+	unsigned int hash = hashName(string);
+	if (object->_index) {
+		for (unsigned int i = hash & object->_indexMask;; i = (i + 1) & object->_indexMask) {
+			Json *c = object->_index[i];
+			if (!c || (c->_nameHash == hash && !json_strcasecmp(c->_name, string))) return c;
+		}
+	}
 	Json *c = object->_child;
-	while (c && json_strcasecmp(c->_name, string)) {
+	while (c && (c->_nameHash != hash || json_strcasecmp(c->_name, string))) {
 		c = c->_next;
 	}
 	return c;
@@ -104,7 +198,24 @@ bool Json::getBoolean(spine::Json *value, const char *name, bool defaultValue) {
 }
 
 const char *Json::getError() {
-	return _error;
+	return parseError;
+}
+
+Json::Json() : _next(NULL),
+#if SPINE_JSON_HAVE_PREV
+			   _prev(NULL),
+#endif
+			   _child(NULL),
+			   _type(0),
+			   _size(0),
+			   _valueString(NULL),
+			   _valueInt(0),
+			   _valueFloat(0),
+			   _name(NULL),
+			   _nameHash(0),
+			   _indexMask(0),
+			   _index(NULL),
+			   _arena(NULL) {
 }
 
 Json::Json(const char *value) : _next(NULL),
@@ -117,32 +228,22 @@ Json::Json(const char *value) : _next(NULL),
 								_valueString(NULL),
 								_valueInt(0),
 								_valueFloat(0),
-								_name(NULL) {
+								_name(NULL),
+								_nameHash(0),
+								_indexMask(0),
+								_index(NULL),
+								_arena(NULL) {
 	if (value) {
-		value = parseValue(this, skip(value));
+		_arena = new (__FILE__, __LINE__) Arena(strlen(value));
+		value = parseValue(this, skip(value), _arena);
 
 		assert(value);
 	}
 }
 
 Json::~Json() {
-	spine::Json *curr = NULL;
-	spine::Json *next = _child;
-	do {
-		curr = next;
-		if (curr) {
-			next = curr->_next;
-		}
-		delete curr;
-	} while (next);
-
-	if (_valueString) {
-		SpineExtension::free(_valueString, __FILE__, __LINE__);
-	}
-
-	if (_name) {
-		SpineExtension::free(_name, __FILE__, __LINE__);
-	}
+	/* Items are owned by the root's arena. */
+	delete _arena;
 }
 
 const char *Json::skip(const char *inValue) {
@@ -158,7 +259,7 @@ const char *Json::skip(const char *inValue) {
 	return inValue;
 }
 
-const char *Json::parseValue(Json *item, const char *value) {
+const char *Json::parseValue(Json *item, const char *value, Arena *arena) {
 	/* Referenced by constructor, parseArray(), and parseObject(). */
 	/* Always called with the result of skip(). */
 #ifdef SPINE_JSON_DEBUG /* Checked at entry to graph, constructor, and after every parse call. */
@@ -193,11 +294,11 @@ const char *Json::parseValue(Json *item, const char *value) {
 			break;
 		}
 		case '\"':
-			return parseString(item, value);
+			return parseString(item, value, arena);
 		case '[':
-			return parseArray(item, value);
+			return parseArray(item, value, arena);
 		case '{':
-			return parseObject(item, value);
+			return parseObject(item, value, arena);
 		case '-': /* fallthrough */
 		case '0': /* fallthrough */
 		case '1': /* fallthrough */
@@ -214,42 +315,67 @@ const char *Json::parseValue(Json *item, const char *value) {
 			break;
 	}
 
-	_error = value;
+	parseError = value;
 	return NULL; /* failure. */
 }
 
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 
-const char *Json::parseString(Json *item, const char *str) {
+static unsigned parseHex4(const char *str) {
+	unsigned value = 0;
+	for (int i = 0; i < 4; i++) {
+		char c = str[i];
+		value <<= 4;
+		if (c >= '0' && c <= '9')
+			value |= c - '0';
+		else if (c >= 'a' && c <= 'f')
+			value |= c - 'a' + 10;
+		else if (c >= 'A' && c <= 'F')
+			value |= c - 'A' + 10;
+		else
+			return 0;
+	}
+	return value;
+}
+
+const char *Json::parseString(Json *item, const char *str, Arena *arena) {
 	const char *ptr = str + 1;
-	char *ptr2;
-	char *out;
-	int len = 0;
-	unsigned uc, uc2;
 	if (*str != '\"') {
 		/* TODO: don't need this check when called from parseValue, but do need from parseObject */
-		_error = str;
+		parseError = str;
 		return 0;
 	} /* not a string! */
 
-	while (*ptr != '\"' && *ptr && ++len) {
-		if (*ptr++ == '\\') {
-			ptr++; /* Skip escaped quotes. */
-		}
-	}
-
-	out = SpineExtension::alloc<char>(len + 1, __FILE__, __LINE__); /* The length needed for the string, roughly. */
-	if (!out) {
-		return 0;
-	}
+	/* Most strings have no escapes and are interned as they are in the text. */
+	while (*ptr != '\"' && *ptr != '\\' && *ptr) ptr++;
+	if (*ptr != '\\') {
+		item->_valueString = arena->intern(str + 1, ptr - str - 1);
+		item->_type = JSON_STRING;
+		return *ptr ? ptr + 1 : ptr;
+	}
+
+	/* Unescaped text is never longer than the escaped text. */
+	const char *end = ptr;
+	while (*end != '\"' && *end) end += end[0] == '\\' && end[1] ? 2 : 1;
+	arena->scratch.setSize(end - str, 0);
+	size_t length;
+	ptr = unescapeString(str, arena->scratch.buffer(), length);
+	item->_valueString = arena->intern(arena->scratch.buffer(), length);
+	item->_type = JSON_STRING;
+	return ptr;
+}
 
-	ptr = str + 1;
-	ptr2 = out;
+const char *Json::unescapeString(const char *str, char *out, size_t &length) {
+	const char *ptr = str + 1;
+	char *ptr2 = out;
+	int len;
+	unsigned uc, uc2;
 	while (*ptr != '\"' && *ptr) {
 		if (*ptr != '\\') {
 			*ptr2++ = *ptr++;
 		} else {
 			ptr++;
+			if (!*ptr) break;
 			switch (*ptr) {
 				case 'b':
 					*ptr2++ = '\b';
@@ -268,7 +394,7 @@ const char *Json::parseString(Json *item, const char *str) {
 					break;
 				case 'u': {
 					/* transcode utf16 to utf8. */
-					sscanf(ptr + 1, "%4x", &uc);
+					uc = parseHex4(ptr + 1);
 					ptr += 4; /* get the unicode char. */
 
 					if ((uc >= 0xDC00 && uc <= 0xDFFF) || uc == 0) {
@@ -280,7 +406,7 @@ const char *Json::parseString(Json *item, const char *str) {
 						if (ptr[1] != '\\' || ptr[2] != 'u') {
 							break; /* missing second-half of surrogate.	*/
 						}
-						sscanf(ptr + 3, "%4x", &uc2);
+						uc2 = parseHex4(ptr + 3);
 						ptr += 6;
 						if (uc2 < 0xDC00 || uc2 > 0xDFFF) {
 							break; /* invalid second-half of surrogate.	*/
@@ -325,88 +451,90 @@ const char *Json::parseString(Json *item, const char *str) {
 		}
 	}
 
-	*ptr2 = 0;
-
 	if (*ptr == '\"') {
 		ptr++; /* TODO error handling if not \" or \0 ? */
 	}
-
-	item->_valueString = out;
-	item->_type = JSON_STRING;
-
+	*ptr2 = 0;
+	length = ptr2 - out;
 	return ptr;
 }
 
+/* Exactly representable powers of ten. Scaling a mantissa of at most 15 digits by one of these is correctly rounded. */
+static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+									1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
 const char *Json::parseNumber(Json *item, const char *num) {
-	double result = 0.0;
-	int negative = 0;
-	char *ptr = (char *) num;
+	unsigned long long mantissa = 0;
+	int digits = 0, exponent = 0;
+	bool negative = false;
+	const char *ptr = num;
 
 	if (*ptr == '-') {
-		negative = -1;
+		negative = true;
 		++ptr;
 	}
 
+	/* Accumulate up to 19 significant digits as an integer, then apply the decimal exponent once. */
 	while (*ptr >= '0' && *ptr <= '9') {
-		result = result * 10.0 + (*ptr - '0');
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (*ptr - '0');
+			if (mantissa) digits++;
+		} else
+			exponent++;
 		++ptr;
 	}
 
 	if (*ptr == '.') {
-		double fraction = 0.0;
-		int n = 0;
 		++ptr;
-
 		while (*ptr >= '0' && *ptr <= '9') {
-			fraction = (fraction * 10.0) + (*ptr - '0');
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*ptr - '0');
+				if (mantissa) digits++;
+				exponent--;
+			}
 			++ptr;
-			++n;
 		}
-		result += fraction / pow(10.0, n);
-	}
-
-	if (negative) {
-		result = -result;
 	}
 
 	if (*ptr == 'e' || *ptr == 'E') {
-		double exponent = 0;
-		int expNegative = 0;
+		int value = 0;
+		bool expNegative = false;
 		++ptr;
 
 		if (*ptr == '-') {
-			expNegative = -1;
+			expNegative = true;
 			++ptr;
 		} else if (*ptr == '+') {
 			++ptr;
 		}
 
 		while (*ptr >= '0' && *ptr <= '9') {
-			exponent = (exponent * 10.0) + (*ptr - '0');
+			if (value < 10000) value = value * 10 + (*ptr - '0');
 			++ptr;
 		}
-
-		if (expNegative) {
-			result = result / pow(10, exponent);
-		} else {
-			result = result * pow(10, exponent);
-		}
+		exponent += expNegative ? -value : value;
 	}
 
 	if (ptr != num) {
 		/* Parse success, number found. */
+		double result = (double) mantissa;
+		if (exponent < 0)
+			result = exponent >= -22 ? result / powersOf10[-exponent] : result / pow(10.0, -exponent);
+		else if (exponent > 0)
+			result = exponent <= 22 ? result * powersOf10[exponent] : result * pow(10.0, exponent);
+		if (negative) result = -result;
 		item->_valueFloat = (float) result;
 		item->_valueInt = (int) result;
 		item->_type = JSON_NUMBER;
 		return ptr;
 	} else {
-		/* Parse failure, _error is set. */
-		_error = num;
+		/* Parse failure, parseError is set. */
+		parseError = num;
 		return NULL;
 	}
 }
 
-const char *Json::parseArray(Json *item, const char *value) {
+const char *Json::parseArray(Json *item, const char *value, Arena *arena) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -422,12 +550,9 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
-	if (!item->_child) {
-		return NULL; /* memory fail */
-	}
+	item->_child = child = arena->newNode();
 
-	value = skip(parseValue(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parseValue(child, skip(value), arena)); /* skip any spacing, get the value. */
 
 	if (!value) {
 		return NULL;
@@ -436,16 +561,13 @@ const char *Json::parseArray(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
-		if (!new_item) {
-			return NULL; /* memory fail */
-		}
+		Json *new_item = arena->newNode();
 		child->_next = new_item;
 #if SPINE_JSON_HAVE_PREV
-		new_item->prev = child;
+		new_item->_prev = child;
 #endif
 		child = new_item;
-		value = skip(parseValue(child, skip(value + 1)));
+		value = skip(parseValue(child, skip(value + 1), arena));
 		if (!value) {
 			return NULL; /* parse fail */
 		}
@@ -456,13 +578,13 @@ const char *Json::parseArray(Json *item, const char *value) {
 		return value + 1; /* end of array */
 	}
 
-	_error = value;
+	parseError = value;
 
 	return NULL; /* malformed. */
 }
 
 /* Build an object from the text. */
-const char *Json::parseObject(Json *item, const char *value) {
+const char *Json::parseObject(Json *item, const char *value, Arena *arena) {
 	Json *child;
 
 #ifdef SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
@@ -478,22 +600,20 @@ const char *Json::parseObject(Json *item, const char *value) {
 		return value + 1; /* empty array. */
 	}
 
-	item->_child = child = new (__FILE__, __LINE__) Json(NULL);
-	if (!item->_child) {
-		return NULL;
-	}
-	value = skip(parseString(child, skip(value)));
+	item->_child = child = arena->newNode();
+	value = skip(parseString(child, skip(value), arena));
 	if (!value) {
 		return NULL;
 	}
 	child->_name = child->_valueString;
+	child->_nameHash = hashName(child->_name);
 	child->_valueString = 0;
 	if (*value != ':') {
-		_error = value;
+		parseError = value;
 		return NULL;
 	} /* fail! */
 
-	value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parseValue(child, skip(value + 1), arena)); /* skip any spacing, get the value. */
 	if (!value) {
 		return NULL;
 	}
@@ -501,27 +621,25 @@ const char *Json::parseObject(Json *item, const char *value) {
 	item->_size = 1;
 
 	while (*value == ',') {
-		Json *new_item = new (__FILE__, __LINE__) Json(NULL);
-		if (!new_item) {
-			return NULL; /* memory fail */
-		}
+		Json *new_item = arena->newNode();
 		child->_next = new_item;
 #if SPINE_JSON_HAVE_PREV
-		new_item->prev = child;
+		new_item->_prev = child;
 #endif
 		child = new_item;
-		value = skip(parseString(child, skip(value + 1)));
+		value = skip(parseString(child, skip(value + 1), arena));
 		if (!value) {
 			return NULL;
 		}
 		child->_name = child->_valueString;
+		child->_nameHash = hashName(child->_name);
 		child->_valueString = 0;
 		if (*value != ':') {
-			_error = value;
+			parseError = value;
 			return NULL;
 		} /* fail! */
 
-		value = skip(parseValue(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parseValue(child, skip(value + 1), arena)); /* skip any spacing, get the value. */
 		if (!value) {
 			return NULL;
 		}
@@ -529,14 +647,41 @@ const char *Json::parseObject(Json *item, const char *value) {
 	}
 
 	if (*value == '}') {
+		/* Larger objects are indexed by name. Scanning the few nodes of a small object is as fast. */
+		if (item->_size > IndexedSize) buildIndex(item, arena);
 		return value + 1; /* end of array */
 	}
 
-	_error = value;
+	parseError = value;
 
 	return NULL; /* malformed. */
 }
 
+void Json::buildIndex(Json *object, Arena *arena) {
+	unsigned int capacity = 16;
+	while (capacity < (unsigned int) object->_size * 2) capacity <<= 1;
+	object->_index = (Json **) arena->allocate(capacity * sizeof(Json *), sizeof(Json *));
+	memset(object->_index, 0, capacity * sizeof(Json *));
+	object->_indexMask = capacity - 1;
+	/* Items are inserted in order, so the first of several with the same name is found first. */
+	for (Json *child = object->_child; child; child = child->_next) {
+		unsigned int i = child->_nameHash & object->_indexMask;
+		while (object->_index[i]) i = (i + 1) & object->_indexMask;
+		object->_index[i] = child;
+	}
+}
+
+unsigned int Json::hashName(const char *name) {
+	/* FNV-1a over ASCII lowercased characters, matching json_strcasecmp. */
+	unsigned int hash = 2166136261u;
+	for (; *name; name++) {
+		unsigned char c = (unsigned char) *name;
+		if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+		hash = (hash ^ c) * 16777619u;
+	}
+	return hash;
+}
+
 int Json::json_strcasecmp(const char *s1, const char *s2) {
 	/* TODO we may be able to elide these NULL checks if we can prove
 	 * the graph and input (only callsite is Json_getItem) should not have NULLs
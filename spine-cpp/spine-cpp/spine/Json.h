@@ -40,6 +40,7 @@
 namespace spine {
 	class SP_API Json : public SpineObject {
 		friend class SkeletonJson;
+		friend class JsonAnimationDecoder;
 
 	public:
 		/* Json Types: */
@@ -67,14 +68,19 @@ namespace spine {
 		/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
 		static const char *getError();
 
-		/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
+		/* Supply a block of JSON, and this returns a Json object you can interrogate. Delete it when finished. The text
+		 * is only read while parsing, so the block can be released or unmapped afterwards. */
 		explicit Json(const char *value);
 
 		~Json();
 
 
 	private:
-		static const char *_error;
+		/* Owns the nodes, member indexes and strings of a parsed document. */
+		struct Arena;
+
+		/* Objects with more items than this are indexed by name. */
+		static const int IndexedSize = 4;
 
 		Json *_next;
 #if SPINE_JSON_HAVE_PREV
@@ -90,24 +96,39 @@ namespace spine {
 		float _valueFloat; /* The item's number, if type==JSON_NUMBER */
 
 		const char *_name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
+		unsigned int _nameHash; /* Case insensitive hash of _name, compared before the name by getItem. */
+		unsigned int _indexMask; /* The number of slots in _index minus one. */
+		Json **_index; /* An object's items by _nameHash, open addressed, or NULL for small objects. */
+
+		Arena *_arena; /* Set for the document root, which owns the arena. */
+
+		Json();
 
 		/* Utility to jump whitespace and cr/lf */
 		static const char *skip(const char *inValue);
 
 		/* Parser core - when encountering text, process appropriately. */
-		static const char *parseValue(Json *item, const char *value);
+		static const char *parseValue(Json *item, const char *value, Arena *arena);
 
-		/* Parse the input text into an unescaped cstring, and populate item. */
-		static const char *parseString(Json *item, const char *str);
+		/* Parse the input text into an unescaped cstring in the arena, and populate item. */
+		static const char *parseString(Json *item, const char *str, Arena *arena);
+
+		/* Unescape the string starting at its opening quote into out, which needs room for the escaped text. Returns
+		 * the character after the closing quote. */
+		static const char *unescapeString(const char *str, char *out, size_t &length);
 
 		/* Parse the input text to generate a number, and populate the result into item. */
 		static const char *parseNumber(Json *item, const char *num);
 
 		/* Build an array from input text. */
-		static const char *parseArray(Json *item, const char *value);
+		static const char *parseArray(Json *item, const char *value, Arena *arena);
 
 		/* Build an object from the text. */
-		static const char *parseObject(Json *item, const char *value);
+		static const char *parseObject(Json *item, const char *value, Arena *arena);
+
+		static void buildIndex(Json *object, Arena *arena);
+
+		static unsigned int hashName(const char *name);
 
 		static int json_strcasecmp(const char *s1, const char *s2);
 	};
@@ -35,6 +35,7 @@ RTTI_IMPL(MeshAttachment, VertexAttachment)
 
 MeshAttachment::MeshAttachment(const String &name) : VertexAttachment(name),
 													 _parentMesh(NULL),
+													 _uvsVersion(0),
 													 _path(),
 													 _color(1, 1, 1, 1),
 													 _hullLength(0),
@@ -48,6 +49,7 @@ MeshAttachment::~MeshAttachment() {
 }
 
 void MeshAttachment::updateRegion() {
+	_uvsVersion++;
 	if (_uvs.size() != _regionUVs.size()) {
 		_uvs.setSize(_regionUVs.size(), 0);
 	}
@@ -130,6 +132,10 @@ Vector<float> &MeshAttachment::getUVs() {
 	return _uvs;
 }
 
+int MeshAttachment::getUVsVersion() {
+	return _uvsVersion;
+}
+
 Vector<unsigned short> &MeshAttachment::getTriangles() {
 	return _triangles;
 }
@@ -69,6 +69,9 @@ namespace spine {
 		/// The UV pair for each vertex, normalized within the entire texture. See also MeshAttachment::updateRegion
 		Vector<float> &getUVs();
 
+		/// Incremented whenever updateRegion() recomputes the UVs.
+		int getUVsVersion();
+
 		Vector<unsigned short> &getTriangles();
 
 		Color &getColor();
@@ -107,6 +110,7 @@ namespace spine {
 	private:
 		MeshAttachment *_parentMesh;
 		Vector<float> _uvs;
+		int _uvsVersion;
 		Vector<float> _regionUVs;
 		Vector<unsigned short> _triangles;
 		Vector<unsigned short> _edges;
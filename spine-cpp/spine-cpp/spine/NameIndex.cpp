@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/NameIndex.h>
+
+using namespace spine;
+
+NameHash::NameHash(const String &name) : _name(name), _hash(hash(name)) {
+}
+
+NameHash::NameHash(const char *name) : _name(name), _hash(hash(_name)) {
+}
+
+unsigned int NameHash::hash(const String &name) {
+	/* FNV-1a. */
+	const unsigned char *bytes = (const unsigned char *) name.buffer();
+	unsigned int hash = 2166136261u;
+	for (size_t i = 0, n = name.length(); i < n; ++i) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+NameIndex::NameIndex() : _size(0), _count(0) {
+}
+
+void NameIndex::clear() {
+	_slots.clear();
+	_hashes.clear();
+	_size = 0;
+	_count = 0;
+}
+
+void NameIndex::insert(unsigned int hash, int index) {
+	/* Linear probing in a power of two table that is kept at most half full. */
+	if ((_count + 1) * 2 > _slots.size()) {
+		Vector<int> slots(std::move(_slots));
+		Vector<unsigned int> hashes(std::move(_hashes));
+		size_t capacity = slots.size() < 16 ? 16 : slots.size() << 1;
+		_slots.setSize(capacity, -1);
+		_hashes.setSize(capacity, 0);
+		_count = 0;
+		for (size_t i = 0, n = slots.size(); i < n; ++i)
+			if (slots[i] != -1) insert(hashes[i], slots[i]);
+	}
+	size_t mask = _slots.size() - 1;
+	size_t i = hash & mask;
+	while (_slots[i] != -1)
+		i = (i + 1) & mask;
+	_slots[i] = index;
+	_hashes[i] = hash;
+	_count++;
+}
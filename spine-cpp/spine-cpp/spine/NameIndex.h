@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_NameIndex_h
+#define Spine_NameIndex_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	/// A name and its hash, computed once. Find methods taking a NameHash don't hash the name again, so code that looks
+	/// up the same names repeatedly can keep NameHash instances around.
+	class SP_API NameHash : public SpineObject {
+	public:
+		explicit NameHash(const String &name);
+
+		explicit NameHash(const char *name);
+
+		const String &getName() const { return _name; }
+
+		unsigned int getHash() const { return _hash; }
+
+		static unsigned int hash(const String &name);
+
+	private:
+		String _name;
+		unsigned int _hash;
+	};
+
+	/// A hash index from names to positions in a vector of named items. Items appended to the vector are added by
+	/// update(). Lookups fall back to a linear search while the index doesn't cover the whole vector, so they never
+	/// miss an item because the index is out of date. Lookups don't modify the index and may run concurrently.
+	class SP_API NameIndex : public SpineObject {
+	public:
+		NameIndex();
+
+		/// Indexes the items added since the last update. Stops at the first NULL item, so a vector that is being
+		/// filled in can be updated again later. If the vector shrank, the index is rebuilt. When several items have
+		/// the same name, the first one is found.
+		template<typename T>
+		void update(Vector<T *> &items) {
+			if (items.size() < _size) clear();
+			for (; _size < items.size(); _size++) {
+				T *item = items[_size];
+				if (!item) break;
+				unsigned int hash = NameHash::hash(item->getName());
+				if (lookup(items, item->getName(), hash) == -1) insert(hash, (int) _size);
+			}
+		}
+
+		void clear();
+
+		/// @return The index of the first item with the name, or -1.
+		template<typename T>
+		int find(Vector<T *> &items, const String &name) const {
+			if (_size != items.size()) return search(items, name);
+			return lookup(items, name, NameHash::hash(name));
+		}
+
+		/// @return The index of the first item with the name, or -1.
+		template<typename T>
+		int find(Vector<T *> &items, const NameHash &name) const {
+			if (_size != items.size()) return search(items, name.getName());
+			return lookup(items, name.getName(), name.getHash());
+		}
+
+		/// @return The first item with the name, or NULL.
+		template<typename T, typename Name>
+		T *findItem(Vector<T *> &items, const Name &name) const {
+			int index = find(items, name);
+			return index == -1 ? NULL : items[index];
+		}
+
+	private:
+		Vector<int> _slots;
+		Vector<unsigned int> _hashes;
+		size_t _size;
+		size_t _count;
+
+		void insert(unsigned int hash, int index);
+
+		template<typename T>
+		int lookup(Vector<T *> &items, const String &name, unsigned int hash) const {
+			if (_count == 0) return -1;
+			size_t mask = _slots.size() - 1;
+			for (size_t i = hash & mask;; i = (i + 1) & mask) {
+				int index = _slots[i];
+				if (index == -1) return -1;
+				if (_hashes[i] == hash && items[index]->getName() == name) return index;
+			}
+		}
+
+		template<typename T>
+		static int search(Vector<T *> &items, const String &name) {
+			for (size_t i = 0, n = items.size(); i < n; ++i) {
+				if (items[i] && items[i]->getName() == name) return (int) i;
+			}
+			return -1;
+		}
+	};
+}
+
+#endif /* Spine_NameIndex_h */
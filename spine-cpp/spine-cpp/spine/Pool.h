@@ -35,39 +35,146 @@
 #include <spine/ContainerUtil.h>
 #include <spine/SpineObject.h>
 
+#include <assert.h>
+#include <new>
+
 namespace spine {
+	/// A pool of reusable objects. Objects are created in chunks of one or more, and free objects are kept in an
+	/// intrusive list, so obtain() and free() take constant time. Objects are not destroyed when freed, and all objects
+	/// the pool created, free or not, are destroyed with the pool.
+	///
+	/// free() only accepts objects obtained from the same pool. Freeing an object twice has no effect. Define
+	/// SPINE_POOL_DEBUG to assert on double frees and on objects from elsewhere.
 	template<typename T>
 	class SP_API Pool : public SpineObject {
 	public:
-		Pool() {
+		struct Stats {
+			/// The number of objects created and the number of those that are free.
+			size_t objects;
+			size_t freeObjects;
+			/// The highest number of objects in use at once.
+			size_t peakInUse;
+			size_t chunks;
+		};
+
+		/// @param chunkSize The number of objects created at once when the pool is empty. With more than one, pooled
+		/// objects share allocations and are contiguous in memory.
+		explicit Pool(size_t chunkSize = 1) : _chunks(NULL), _free(NULL), _chunkSize(chunkSize ? chunkSize : 1) {
+			_stats.objects = 0;
+			_stats.freeObjects = 0;
+			_stats.peakInUse = 0;
+			_stats.chunks = 0;
 		}
 
 		~Pool() {
-			ContainerUtil::cleanUpVectorOfPointers(_objects);
+			for (Chunk *chunk = _chunks, *next; chunk; chunk = next) {
+				next = chunk->next;
+				for (size_t i = 0; i < chunk->size; i++) getObject(getNode(chunk, i))->~T();
+				SpineExtension::free(chunk, __FILE__, __LINE__);
+			}
 		}
 
 		T *obtain() {
-			if (_objects.size() > 0) {
-				T **object = &_objects[_objects.size() - 1];
-				T *ret = *object;
-				_objects.removeAt(_objects.size() - 1);
-
-				return ret;
-			} else {
-				T *ret = new(__FILE__, __LINE__) T();
-
-				return ret;
-			}
+			if (!_free) addChunk(_chunkSize);
+			Node *node = _free;
+			_free = node->next;
+			node->free = false;
+			_stats.freeObjects--;
+			size_t inUse = _stats.objects - _stats.freeObjects;
+			if (inUse > _stats.peakInUse) _stats.peakInUse = inUse;
+			return getObject(node);
 		}
 
 		void free(T *object) {
-			if (!_objects.contains(object)) {
-				_objects.add(object);
+#ifdef SPINE_POOL_DEBUG
+			assert(owns(object));
+#endif
+			Node *node = (Node *) ((char *) object - NodeSize);
+			if (node->free) {
+#ifdef SPINE_POOL_DEBUG
+				assert(false && "Object freed twice");
+#endif
+				return;
 			}
+			node->free = true;
+			node->next = _free;
+			_free = node;
+			_stats.freeObjects++;
+		}
+
+		/// Creates objects so that at least the given number are free, in one chunk.
+		void reserve(size_t count) {
+			if (count > _stats.freeObjects) addChunk(count - _stats.freeObjects);
+		}
+
+		const Stats &getStats() {
+			return _stats;
 		}
 
 	private:
-		Vector<T *> _objects;
+		/* Each object is preceded by a node, padded so objects stay aligned like allocations. Chunks start with a
+		 * header padded to the same size. */
+		static const size_t NodeSize = 16;
+
+		struct Chunk {
+			Chunk *next;
+			size_t size;
+		};
+
+		struct Node {
+			Node *next;
+			bool free;
+		};
+
+
+		Chunk *_chunks;
+		Node *_free;
+		size_t _chunkSize;
+		Stats _stats;
+
+		/* Pooled types may be incomplete where the pool is declared, so their size is only used in functions. */
+		static size_t getStride() {
+			static_assert(sizeof(Chunk) <= NodeSize && sizeof(Node) <= NodeSize, "Pool node too large");
+			static_assert(alignof(T) <= NodeSize, "Pooled type is overaligned");
+			return NodeSize + (sizeof(T) + NodeSize - 1) / NodeSize * NodeSize;
+		}
+
+		static Node *getNode(Chunk *chunk, size_t index) {
+			return (Node *) ((char *) chunk + NodeSize + index * getStride());
+		}
+
+		static T *getObject(Node *node) {
+			return (T *) ((char *) node + NodeSize);
+		}
+
+		void addChunk(size_t size) {
+			Chunk *chunk = (Chunk *) SpineExtension::alloc<char>(NodeSize + size * getStride(), __FILE__, __LINE__);
+			chunk->next = _chunks;
+			chunk->size = size;
+			_chunks = chunk;
+			/* Link the objects in order, so they are obtained in address order. */
+			for (size_t i = size; i-- > 0;) {
+				Node *node = getNode(chunk, i);
+				new (getObject(node)) T();
+				node->free = true;
+				node->next = _free;
+				_free = node;
+			}
+			_stats.objects += size;
+			_stats.freeObjects += size;
+			_stats.chunks++;
+		}
+
+#ifdef SPINE_POOL_DEBUG
+		bool owns(T *object) {
+			for (Chunk *chunk = _chunks; chunk; chunk = chunk->next) {
+				char *start = (char *) getObject(getNode(chunk, 0));
+				if ((char *) object >= start && (char *) object < start + chunk->size * getStride())
+					return ((char *) object - start) % getStride() == 0;
+			}
+			return false;
+		}
+#endif
 	};
 }
 
@@ -0,0 +1,346 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/PoolingSpineExtension.h>
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace spine;
+
+namespace {
+	/* Every block is preceded by a header, which keeps blocks aligned to 16 bytes. Chunks start with a link to the
+	 * next chunk, padded to the same size. */
+	const size_t HeaderSize = 16;
+	const size_t ChunkSize = 64 * 1024;
+	const size_t MaxSmallSize = 1024;
+	const uint32_t LargeClass = 0xffffffff;
+
+	struct Header {
+		uint32_t sizeClass;
+		/* Large allocations only. */
+		size_t size;
+	};
+
+	static_assert(sizeof(Header) <= HeaderSize, "Block header too large");
+
+	/* 16 byte steps up to 128 bytes, then four classes per doubling. */
+	const size_t classSizes[] = {16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 640, 768,
+								 896, 1024};
+
+	/* The size class for each size rounded up to 16 bytes, indexed by size / 16. */
+	const unsigned char sizeClasses[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 12, 12, 13, 13, 13,
+										 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17,
+										 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19,
+										 19};
+
+	inline int getSizeClass(size_t size) {
+		return sizeClasses[(size + 15) >> 4];
+	}
+
+	inline Header *getHeader(void *mem) {
+		return (Header *) ((char *) mem - HeaderSize);
+	}
+
+	/* The number of blocks moved between a thread's list and the shared list at once. A thread keeps at most twice
+	 * as many. */
+	inline int getBatchSize(int sizeClass) {
+		int batch = (int) (16 * 1024 / classSizes[sizeClass]);
+		return batch < 8 ? 8 : (batch > 128 ? 128 : batch);
+	}
+
+	inline void *&next(void *block) {
+		return *(void **) block;
+	}
+
+	/* Counters only written by their own thread don't need atomic increments. */
+	template<typename T>
+	inline void add(std::atomic<T> &counter, T value) {
+		counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+}
+
+class PoolingSpineExtension::ThreadCache {
+public:
+	PoolingSpineExtension *owner;
+	ThreadCache *prev;
+	ThreadCache *next;
+	void *lists[ClassCount];
+	int counts[ClassCount];
+	std::atomic<size_t> allocations;
+	std::atomic<size_t> frees;
+	std::atomic<long long> liveBytes;
+
+	ThreadCache() : owner(NULL), prev(NULL), next(NULL), allocations(0), frees(0), liveBytes(0) {
+		clear();
+	}
+
+	~ThreadCache() {
+		if (owner) owner->detach(*this);
+	}
+
+	void clear() {
+		for (int i = 0; i < ClassCount; i++) {
+			lists[i] = NULL;
+			counts[i] = 0;
+		}
+	}
+};
+
+PoolingSpineExtension::PoolingSpineExtension() : DefaultSpineExtension(), _chunks(NULL), _caches(NULL), _chunkBytes(0),
+												 _largeBytes(0), _largeAllocations(0), _peakReservedBytes(0),
+												 _allocations(0), _frees(0), _liveBytes(0) {
+	for (int i = 0; i < ClassCount; i++) {
+		_lists[i] = NULL;
+		_counts[i] = 0;
+	}
+}
+
+PoolingSpineExtension::~PoolingSpineExtension() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (ThreadCache *cache = _caches; cache; cache = cache->next) {
+		cache->clear();
+		cache->owner = NULL;
+	}
+	for (void *chunk = _chunks; chunk;) {
+		void *nextChunk = next(chunk);
+		::free(chunk);
+		chunk = nextChunk;
+	}
+}
+
+PoolingSpineExtension::Stats PoolingSpineExtension::getStats() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	size_t allocations = _allocations, frees = _frees;
+	long long liveBytes = _liveBytes;
+	for (ThreadCache *cache = _caches; cache; cache = cache->next) {
+		allocations += cache->allocations.load(std::memory_order_relaxed);
+		frees += cache->frees.load(std::memory_order_relaxed);
+		liveBytes += cache->liveBytes.load(std::memory_order_relaxed);
+	}
+	Stats stats;
+	stats.allocations = allocations;
+	stats.frees = frees;
+	stats.largeAllocations = _largeAllocations.load(std::memory_order_relaxed);
+	stats.liveBytes = liveBytes > 0 ? (size_t) liveBytes : 0;
+	stats.reservedBytes = _chunkBytes.load(std::memory_order_relaxed) + _largeBytes.load(std::memory_order_relaxed);
+	stats.peakReservedBytes = _peakReservedBytes.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void *PoolingSpineExtension::_alloc(size_t size, const char *file, int line) {
+	SP_UNUSED(file);
+	SP_UNUSED(line);
+
+	if (size == 0) return NULL;
+	ThreadCache &cache = getCache();
+	void *mem;
+	if (size > MaxSmallSize) {
+		mem = allocLarge(size);
+		if (!mem) return NULL;
+	} else {
+		int sizeClass = getSizeClass(size);
+		mem = cache.lists[sizeClass];
+		if (!mem) {
+			mem = refill(cache, sizeClass);
+			if (!mem) return NULL;
+		}
+		cache.lists[sizeClass] = next(mem);
+		cache.counts[sizeClass]--;
+		size = classSizes[sizeClass];
+	}
+	add(cache.allocations, (size_t) 1);
+	add(cache.liveBytes, (long long) size);
+	return mem;
+}
+
+void *PoolingSpineExtension::_calloc(size_t size, const char *file, int line) {
+	void *mem = _alloc(size, file, line);
+	if (mem) memset(mem, 0, size);
+	return mem;
+}
+
+void *PoolingSpineExtension::_realloc(void *ptr, size_t size, const char *file, int line) {
+	if (size == 0) return NULL;
+	if (!ptr) return _alloc(size, file, line);
+
+	Header *header = getHeader(ptr);
+	size_t oldSize;
+	if (header->sizeClass == LargeClass) {
+		oldSize = header->size;
+		if (size > MaxSmallSize) {
+			Header *moved = (Header *) ::realloc(header, HeaderSize + size);
+			if (!moved) return NULL;
+			moved->size = size;
+			if (size > oldSize) {
+				size_t largeBytes = _largeBytes.fetch_add(size - oldSize, std::memory_order_relaxed) + size - oldSize;
+				updatePeak(_chunkBytes.load(std::memory_order_relaxed) + largeBytes);
+			} else
+				_largeBytes.fetch_sub(oldSize - size, std::memory_order_relaxed);
+			add(getCache().liveBytes, (long long) size - (long long) oldSize);
+			return (char *) moved + HeaderSize;
+		}
+	} else {
+		oldSize = classSizes[header->sizeClass];
+		if (size <= oldSize) return ptr;
+	}
+
+	void *mem = _alloc(size, file, line);
+	if (!mem) return NULL;
+	memcpy(mem, ptr, oldSize < size ? oldSize : size);
+	_free(ptr, file, line);
+	return mem;
+}
+
+void PoolingSpineExtension::_free(void *mem, const char *file, int line) {
+	SP_UNUSED(file);
+	SP_UNUSED(line);
+
+	if (!mem) return;
+	ThreadCache &cache = getCache();
+	Header *header = getHeader(mem);
+	size_t size;
+	if (header->sizeClass == LargeClass) {
+		size = header->size;
+		_largeBytes.fetch_sub(size, std::memory_order_relaxed);
+		::free(header);
+	} else {
+		int sizeClass = (int) header->sizeClass;
+		size = classSizes[sizeClass];
+		next(mem) = cache.lists[sizeClass];
+		cache.lists[sizeClass] = mem;
+		if (++cache.counts[sizeClass] > 2 * getBatchSize(sizeClass)) release(cache, sizeClass);
+	}
+	add(cache.frees, (size_t) 1);
+	add(cache.liveBytes, -(long long) size);
+}
+
+PoolingSpineExtension::ThreadCache &PoolingSpineExtension::getCache() {
+	static thread_local ThreadCache cache;
+	if (cache.owner != this) {
+		if (cache.owner) cache.owner->detach(cache);
+		attach(cache);
+	}
+	return cache;
+}
+
+void PoolingSpineExtension::attach(ThreadCache &cache) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	cache.owner = this;
+	cache.prev = NULL;
+	cache.next = _caches;
+	if (_caches) _caches->prev = &cache;
+	_caches = &cache;
+}
+
+void PoolingSpineExtension::detach(ThreadCache &cache) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (int i = 0; i < ClassCount; i++) {
+		while (cache.lists[i]) {
+			void *block = cache.lists[i];
+			cache.lists[i] = next(block);
+			next(block) = _lists[i];
+			_lists[i] = block;
+			_counts[i]++;
+		}
+	}
+	cache.clear();
+	_allocations += cache.allocations.exchange(0);
+	_frees += cache.frees.exchange(0);
+	_liveBytes += cache.liveBytes.exchange(0);
+	if (cache.prev)
+		cache.prev->next = cache.next;
+	else
+		_caches = cache.next;
+	if (cache.next) cache.next->prev = cache.prev;
+	cache.owner = NULL;
+}
+
+void *PoolingSpineExtension::refill(ThreadCache &cache, int sizeClass) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (!_lists[sizeClass]) {
+		char *chunk = (char *) ::malloc(ChunkSize);
+		if (!chunk) return NULL;
+		next(chunk) = _chunks;
+		_chunks = chunk;
+		size_t chunkBytes = _chunkBytes.fetch_add(ChunkSize, std::memory_order_relaxed) + ChunkSize;
+		updatePeak(chunkBytes + _largeBytes.load(std::memory_order_relaxed));
+
+		/* Blocks are linked from the end of the chunk so they are handed out in address order. */
+		size_t stride = HeaderSize + classSizes[sizeClass];
+		for (int i = (int) ((ChunkSize - HeaderSize) / stride) - 1; i >= 0; i--) {
+			char *block = chunk + HeaderSize + i * stride;
+			((Header *) block)->sizeClass = (uint32_t) sizeClass;
+			void *mem = block + HeaderSize;
+			next(mem) = _lists[sizeClass];
+			_lists[sizeClass] = mem;
+			_counts[sizeClass]++;
+		}
+	}
+	for (int i = getBatchSize(sizeClass); i > 0 && _lists[sizeClass]; i--) {
+		void *block = _lists[sizeClass];
+		_lists[sizeClass] = next(block);
+		_counts[sizeClass]--;
+		next(block) = cache.lists[sizeClass];
+		cache.lists[sizeClass] = block;
+		cache.counts[sizeClass]++;
+	}
+	return cache.lists[sizeClass];
+}
+
+void PoolingSpineExtension::release(ThreadCache &cache, int sizeClass) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (int i = getBatchSize(sizeClass); i > 0; i--) {
+		void *block = cache.lists[sizeClass];
+		cache.lists[sizeClass] = next(block);
+		cache.counts[sizeClass]--;
+		next(block) = _lists[sizeClass];
+		_lists[sizeClass] = block;
+		_counts[sizeClass]++;
+	}
+}
+
+void *PoolingSpineExtension::allocLarge(size_t size) {
+	Header *header = (Header *) ::malloc(HeaderSize + size);
+	if (!header) return NULL;
+	header->sizeClass = LargeClass;
+	header->size = size;
+	_largeAllocations.fetch_add(1, std::memory_order_relaxed);
+	size_t largeBytes = _largeBytes.fetch_add(size, std::memory_order_relaxed) + size;
+	updatePeak(_chunkBytes.load(std::memory_order_relaxed) + largeBytes);
+	return (char *) header + HeaderSize;
+}
+
+void PoolingSpineExtension::updatePeak(size_t reservedBytes) {
+	size_t peak = _peakReservedBytes.load(std::memory_order_relaxed);
+	while (reservedBytes > peak &&
+		   !_peakReservedBytes.compare_exchange_weak(peak, reservedBytes, std::memory_order_relaxed)) {
+	}
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_PoolingSpineExtension_h
+#define Spine_PoolingSpineExtension_h
+
+#include <spine/Extension.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace spine {
+	/// A SpineExtension that serves allocations of up to 1 KiB from free lists of fixed size classes, with one set of
+	/// lists per thread. Bones, slots, track entries and most Vector and String buffers fall in these classes, so
+	/// creating and disposing them rarely reaches malloc. Larger allocations go to malloc directly.
+	///
+	/// Memory for small blocks is taken from the system in 64 KiB chunks and reused, not returned, until the extension
+	/// is destroyed. Blocks freed on another thread than the one that allocated them go to the freeing thread's lists.
+	/// Install the extension with SpineExtension::setInstance() before spine-cpp allocates anything, and keep it alive
+	/// until all spine-cpp objects have been disposed.
+	class SP_API PoolingSpineExtension : public DefaultSpineExtension {
+	public:
+		struct Stats {
+			/// The number of allocations and frees, including reallocations that moved a block.
+			size_t allocations;
+			size_t frees;
+			/// The number of allocations that were too large for the size classes.
+			size_t largeAllocations;
+			/// The bytes in allocated blocks, rounded up to their size class.
+			size_t liveBytes;
+			/// The bytes taken from the system: chunks for small blocks plus live large allocations.
+			size_t reservedBytes;
+			size_t peakReservedBytes;
+		};
+
+		PoolingSpineExtension();
+
+		/// Releases all chunks. Memory still allocated from the extension becomes invalid.
+		virtual ~PoolingSpineExtension();
+
+		Stats getStats();
+
+	protected:
+		virtual void *_alloc(size_t size, const char *file, int line) override;
+
+		virtual void *_calloc(size_t size, const char *file, int line) override;
+
+		virtual void *_realloc(void *ptr, size_t size, const char *file, int line) override;
+
+		virtual void _free(void *mem, const char *file, int line) override;
+
+	private:
+		static const int ClassCount = 20;
+
+		class ThreadCache;
+
+		std::mutex _mutex;
+		void *_lists[ClassCount];
+		int _counts[ClassCount];
+		void *_chunks;
+		ThreadCache *_caches;
+		std::atomic<size_t> _chunkBytes;
+		std::atomic<size_t> _largeBytes;
+		std::atomic<size_t> _largeAllocations;
+		std::atomic<size_t> _peakReservedBytes;
+		/* Counters of threads that have exited or switched to another extension. */
+		size_t _allocations;
+		size_t _frees;
+		long long _liveBytes;
+
+		ThreadCache &getCache();
+
+		void attach(ThreadCache &cache);
+
+		void detach(ThreadCache &cache);
+
+		void *refill(ThreadCache &cache, int sizeClass);
+
+		void release(ThreadCache &cache, int sizeClass);
+
+		void *allocLarge(size_t size);
+
+		void updatePeak(size_t reservedBytes);
+	};
+}
+
+#endif /* Spine_PoolingSpineExtension_h */
@@ -32,25 +32,44 @@
 
 using namespace spine;
 
-RTTI::RTTI(const char *className) : _className(className), _pBaseRTTI(NULL) {
+namespace {
+	unsigned int hashClassName(const char *className) {
+		unsigned int hash = 2166136261u;
+		for (const char *c = className; *c; c++) {
+			hash ^= (unsigned char) *c;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+}
+
+/* The constructors only use the class name. A base RTTI defined in another file may not be constructed yet, so the
+ * ancestors are recorded on first use. */
+RTTI::RTTI(const char *className) : _className(className), _pBaseRTTI(NULL), _hash(hashClassName(className)),
+									_depth(0) {
 }
 
-RTTI::RTTI(const char *className, const RTTI &baseRTTI) : _className(className), _pBaseRTTI(&baseRTTI) {
+RTTI::RTTI(const char *className, const RTTI &baseRTTI) : _className(className), _pBaseRTTI(&baseRTTI),
+														  _hash(hashClassName(className)), _depth(0) {
 }
 
 const char *RTTI::getClassName() const {
 	return _className;
 }
 
-bool RTTI::isExactly(const RTTI &rtti) const {
-	return !strcmp(this->_className, rtti._className);
+int RTTI::recordAncestors() const {
+	/* Threads that get here at the same time store the same values. */
+	int depth = _pBaseRTTI ? _pBaseRTTI->getDepth() + 1 : 1;
+	for (int i = 0, n = depth - 1 < MaxDepth ? depth - 1 : MaxDepth; i < n; i++)
+		_ancestors[i].store(_pBaseRTTI->_ancestors[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	if (depth <= MaxDepth) _ancestors[depth - 1].store(this, std::memory_order_relaxed);
+	_depth.store(depth, std::memory_order_release);
+	return depth;
 }
 
-bool RTTI::instanceOf(const RTTI &rtti) const {
-	const RTTI *pCompare = this;
-	while (pCompare) {
-		if (!strcmp(pCompare->_className, rtti._className)) return true;
-		pCompare = pCompare->_pBaseRTTI;
-	}
-	return false;
+bool RTTI::isDeepInstanceOf(const RTTI &rtti, int depth) const {
+	/* Types deeper than MaxDepth aren't recorded, so the hierarchy is walked. */
+	const RTTI *ancestor = this;
+	for (int i = getDepth(); i > depth; i--) ancestor = ancestor->_pBaseRTTI;
+	return ancestor == &rtti || ancestor->matches(rtti);
 }
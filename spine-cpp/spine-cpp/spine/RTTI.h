@@ -32,7 +32,16 @@
 
 #include <spine/dll.h>
 
+#include <atomic>
+#include <string.h>
+
 namespace spine {
+	/// Runtime type information. Types are identified by their RTTI instance, so isExactly() and instanceOf() only compare
+	/// pointers. If a type's RTTI is duplicated, e.g. when spine-cpp is linked statically into several shared libraries,
+	/// the instances are matched by a hash of the class name and then the name itself.
+	///
+	/// instanceOf() looks up the ancestor at the depth of the other type, which each RTTI records on first use, so its
+	/// cost doesn't depend on the depth of the hierarchy.
 	class SP_API RTTI {
 	public:
 		explicit RTTI(const char *className);
@@ -41,11 +50,22 @@ namespace spine {
 
 		const char *getClassName() const;
 
-		bool isExactly(const RTTI &rtti) const;
+		bool isExactly(const RTTI &rtti) const {
+			return this == &rtti || matches(rtti);
+		}
 
-		bool instanceOf(const RTTI &rtti) const;
+		bool instanceOf(const RTTI &rtti) const {
+			if (this == &rtti) return true;
+			int depth = rtti.getDepth();
+			if (depth > getDepth()) return false;
+			if (depth > MaxDepth) return isDeepInstanceOf(rtti, depth);
+			const RTTI *ancestor = _ancestors[depth - 1].load(std::memory_order_relaxed);
+			return ancestor == &rtti || ancestor->matches(rtti);
+		}
 
 	private:
+		static const int MaxDepth = 8;
+
 		// Prevent copying
 		RTTI(const RTTI &obj);
 
@@ -53,6 +73,24 @@ namespace spine {
 
 		const char *_className;
 		const RTTI *_pBaseRTTI;
+		unsigned int _hash;
+		/* 0 until the ancestors have been recorded, then the number of types from the root to this type. */
+		mutable std::atomic<int> _depth;
+		/* The ancestors by depth, starting with the root. Only the first MaxDepth are recorded. */
+		mutable std::atomic<const RTTI *> _ancestors[MaxDepth];
+
+		bool matches(const RTTI &rtti) const {
+			return _hash == rtti._hash && !strcmp(_className, rtti._className);
+		}
+
+		int getDepth() const {
+			int depth = _depth.load(std::memory_order_acquire);
+			return depth ? depth : recordAncestors();
+		}
+
+		int recordAncestors() const;
+
+		bool isDeepInstanceOf(const RTTI &rtti, int depth) const;
 	};
 }
 
@@ -55,6 +55,7 @@ RegionAttachment::RegionAttachment(const String &name) : Attachment(name),
 														 _scaleY(1),
 														 _width(0),
 														 _height(0),
+														 _uvsVersion(0),
 														 _path(),
 														 _color(1, 1, 1, 1),
 														 _region(NULL),
@@ -68,6 +69,7 @@ RegionAttachment::~RegionAttachment() {
 }
 
 void RegionAttachment::updateRegion() {
+	_uvsVersion++;
 	if (_region == NULL) {
 		_uvs[BLX] = 0;
 		_uvs[BLY] = 0;
@@ -252,6 +254,10 @@ Vector<float> &RegionAttachment::getUVs() {
 	return _uvs;
 }
 
+int RegionAttachment::getUVsVersion() {
+	return _uvsVersion;
+}
+
 spine::Color &RegionAttachment::getColor() {
 	return _color;
 }
@@ -115,6 +115,9 @@ namespace spine {
 
 		Vector<float> &getUVs();
 
+		/// Incremented whenever updateRegion() recomputes the UVs.
+		int getUVsVersion();
+
 		virtual Attachment *copy();
 
 	private:
@@ -128,8 +131,9 @@ namespace spine {
 		static const int BRY;
 
 		float _x, _y, _rotation, _scaleX, _scaleY, _width, _height;
-		Vector<float> _vertexOffset;
-		Vector<float> _uvs;
+		InlineVector<float, NUM_UVS> _vertexOffset;
+		InlineVector<float, NUM_UVS> _uvs;
+		int _uvsVersion;
 		String _path;
 		Color _color;
 		TextureRegion *_region;
@@ -318,12 +318,29 @@ void Skeleton::setSlotsToSetupPose() {
 	}
 }
 
+/* Bones and slots are created in the same order as their data, so the data's index locates them. */
+template<typename T, typename D>
+static T *findWithData(Vector<T *> &items, D *data) {
+	if (!data) return NULL;
+	int index = data->getIndex();
+	if (index < (int) items.size() && &items[index]->getData() == data) return items[index];
+	return ContainerUtil::findWithDataName(items, data->getName());
+}
+
 Bone *Skeleton::findBone(const String &boneName) {
-	return ContainerUtil::findWithDataName(_bones, boneName);
+	return findWithData(_bones, _data->findBone(boneName));
+}
+
+Bone *Skeleton::findBone(const NameHash &boneName) {
+	return findWithData(_bones, _data->findBone(boneName));
 }
 
 Slot *Skeleton::findSlot(const String &slotName) {
-	return ContainerUtil::findWithDataName(_slots, slotName);
+	return findWithData(_slots, _data->findSlot(slotName));
+}
+
+Slot *Skeleton::findSlot(const NameHash &slotName) {
+	return findWithData(_slots, _data->findSlot(slotName));
 }
 
 void Skeleton::setSkin(const String &skinName) {
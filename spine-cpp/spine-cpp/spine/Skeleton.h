@@ -58,6 +58,8 @@ namespace spine {
 
 	class Attachment;
 
+	class NameHash;
+
     class SkeletonClipping;
 
 	class SP_API Skeleton : public SpineObject {
@@ -144,12 +146,20 @@ namespace spine {
 
 		void setSlotsToSetupPose();
 
+		/// Finds a bone using the skeleton data's name index.
 		/// @return May be NULL.
 		Bone *findBone(const String &boneName);
 
+		/// @return May be NULL.
+		Bone *findBone(const NameHash &boneName);
+
+		/// Finds a slot using the skeleton data's name index.
 		/// @return May be NULL.
 		Slot *findSlot(const String &slotName);
 
+		/// @return May be NULL.
+		Slot *findSlot(const NameHash &slotName);
+
 		/// Sets a skin by name (see setSkin).
 		void setSkin(const String &skinName);
 
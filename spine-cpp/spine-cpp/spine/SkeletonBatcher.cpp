@@ -0,0 +1,247 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonBatcher.h>
+#include <spine/Skeleton.h>
+
+#include <cfloat>
+#include <chrono>
+
+using namespace spine;
+
+typedef std::chrono::steady_clock BatcherClock;
+
+static double elapsedMs(BatcherClock::time_point start) {
+	return std::chrono::duration<double, std::milli>(BatcherClock::now() - start).count();
+}
+
+static RenderCommand *allocateCommand(BlockAllocator &allocator, int numVertices, int numIndices, BlendMode blendMode, void *texture) {
+	RenderCommand *cmd = allocator.allocate<RenderCommand>(1);
+	cmd->positions = allocator.allocate<float>(numVertices << 1);
+	cmd->uvs = allocator.allocate<float>(numVertices << 1);
+	cmd->colors = allocator.allocate<uint32_t>(numVertices);
+	cmd->darkColors = allocator.allocate<uint32_t>(numVertices);
+	cmd->numVertices = numVertices;
+	cmd->indices = allocator.allocate<uint16_t>(numIndices);
+	cmd->numIndices = numIndices;
+	cmd->blendMode = blendMode;
+	cmd->texture = texture;
+	cmd->buffersOwner = nullptr;
+	cmd->buffersVersion = 0;
+	cmd->next = nullptr;
+	return cmd;
+}
+
+static bool canMerge(RenderCommand *a, RenderCommand *b) {
+	return a->texture == b->texture && a->blendMode == b->blendMode;
+}
+
+SkeletonBatcher::SkeletonBatcher() : _renderer(), _allocator(16384), _items(), _sorted(), _placed(), _commands(), _reorder(true) {
+	memset(&_stats, 0, sizeof(SkeletonBatcherStats));
+}
+
+SkeletonBatcher::~SkeletonBatcher() {
+}
+
+void SkeletonBatcher::begin() {
+	BatcherClock::time_point start = BatcherClock::now();
+	_allocator.compress();
+	_items.clear();
+	memset(&_stats, 0, sizeof(SkeletonBatcherStats));
+	_stats.cpuTimeMs = elapsedMs(start);
+}
+
+void SkeletonBatcher::add(Skeleton &skeleton, int layer, const float *transform) {
+	BatcherClock::time_point start = BatcherClock::now();
+	Item item = {layer, (int) _items.size(), nullptr, nullptr, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	for (RenderCommand *cmd = _renderer.render(skeleton); cmd; cmd = cmd->next) {
+		int numVertices = cmd->numVertices;
+		RenderCommand *copy = allocateCommand(_allocator, numVertices, cmd->numIndices, cmd->blendMode, cmd->texture);
+		float *src = cmd->positions, *dst = copy->positions;
+		for (int i = 0, n = numVertices << 1; i < n; i += 2) {
+			float x = src[i], y = src[i + 1];
+			if (transform) {
+				dst[i] = transform[0] * x + transform[1] * y + transform[4];
+				dst[i + 1] = transform[2] * x + transform[3] * y + transform[5];
+			} else {
+				dst[i] = x;
+				dst[i + 1] = y;
+			}
+			item.minX = MathUtil::min(item.minX, dst[i]);
+			item.minY = MathUtil::min(item.minY, dst[i + 1]);
+			item.maxX = MathUtil::max(item.maxX, dst[i]);
+			item.maxY = MathUtil::max(item.maxY, dst[i + 1]);
+		}
+		memcpy(copy->uvs, cmd->uvs, sizeof(float) * 2 * numVertices);
+		memcpy(copy->colors, cmd->colors, sizeof(uint32_t) * numVertices);
+		memcpy(copy->darkColors, cmd->darkColors, sizeof(uint32_t) * numVertices);
+		memcpy(copy->indices, cmd->indices, sizeof(uint16_t) * cmd->numIndices);
+
+		if (!item.last) item.first = copy;
+		else item.last->next = copy;
+		item.last = copy;
+		_stats.inputCommands++;
+	}
+
+	_items.add(item);
+	_stats.skeletons++;
+	_stats.cpuTimeMs += elapsedMs(start);
+}
+
+RenderCommand *SkeletonBatcher::end() {
+	BatcherClock::time_point start = BatcherClock::now();
+	sortItems();
+
+	_placed.clear();
+	for (int i = 0, n = (int) _sorted.size(); i < n;) {
+		int layerEnd = i + 1;
+		while (layerEnd < n && _items[_sorted[layerEnd]].layer == _items[_sorted[i]].layer) layerEnd++;
+		placeLayer(i, layerEnd);
+		i = layerEnd;
+	}
+
+	RenderCommand *root = mergeCommands();
+	_stats.cpuTimeMs += elapsedMs(start);
+	return root;
+}
+
+const SkeletonBatcherStats &SkeletonBatcher::getStats() {
+	return _stats;
+}
+
+bool SkeletonBatcher::getReorder() {
+	return _reorder;
+}
+
+void SkeletonBatcher::setReorder(bool inValue) {
+	_reorder = inValue;
+}
+
+void SkeletonBatcher::sortItems() {
+	// Stable insertion sort by layer, linear when skeletons are already submitted in layer order.
+	_sorted.setSize(_items.size(), 0);
+	for (int i = 0, n = (int) _items.size(); i < n; i++) {
+		int layer = _items[i].layer;
+		int j = i;
+		for (; j > 0 && _items[_sorted[j - 1]].layer > layer; j--)
+			_sorted[j] = _sorted[j - 1];
+		_sorted[j] = i;
+	}
+}
+
+void SkeletonBatcher::placeLayer(int start, int end) {
+	int layerStart = (int) _placed.size();
+	for (int i = start; i < end; i++) {
+		Item &item = _items[_sorted[i]];
+		if (!item.first) continue;
+
+		int insertAt = (int) _placed.size();
+		if (_reorder) {
+			for (int ii = insertAt - 1; ii >= layerStart; ii--) {
+				Item &other = _items[_placed[ii]];
+				if (canMerge(other.last, item.first)) {
+					insertAt = ii + 1;
+					break;
+				}
+				if (item.minX <= other.maxX && item.maxX >= other.minX && item.minY <= other.maxY && item.maxY >= other.minY)
+					break;
+			}
+		}
+
+		_placed.add(_sorted[i]);
+		for (int ii = (int) _placed.size() - 1; ii > insertAt; ii--)
+			_placed[ii] = _placed[ii - 1];
+		_placed[insertAt] = _sorted[i];
+	}
+}
+
+RenderCommand *SkeletonBatcher::mergeCommands() {
+	_commands.clear();
+	for (int i = 0, n = (int) _placed.size(); i < n; i++) {
+		Item &item = _items[_placed[i]];
+		for (RenderCommand *cmd = item.first;; cmd = cmd->next) {
+			_commands.add(cmd);
+			if (cmd == item.last) break;
+		}
+	}
+
+	RenderCommand *root = nullptr;
+	RenderCommand *last = nullptr;
+	for (int i = 0, n = (int) _commands.size(); i < n;) {
+		RenderCommand *first = _commands[i];
+		int runEnd = i + 1;
+		int numVertices = first->numVertices;
+		int numIndices = first->numIndices;
+		while (runEnd < n && canMerge(first, _commands[runEnd]) &&
+			   numVertices + _commands[runEnd]->numVertices <= 0x10000) {
+			numVertices += _commands[runEnd]->numVertices;
+			numIndices += _commands[runEnd]->numIndices;
+			runEnd++;
+		}
+
+		RenderCommand *batched = first;
+		if (runEnd - i > 1) {
+			batched = allocateCommand(_allocator, numVertices, numIndices, first->blendMode, first->texture);
+			float *positions = batched->positions;
+			float *uvs = batched->uvs;
+			uint32_t *colors = batched->colors;
+			uint32_t *darkColors = batched->darkColors;
+			uint16_t *indices = batched->indices;
+			int indicesOffset = 0;
+			for (int ii = i; ii < runEnd; ii++) {
+				RenderCommand *cmd = _commands[ii];
+				memcpy(positions, cmd->positions, sizeof(float) * 2 * cmd->numVertices);
+				memcpy(uvs, cmd->uvs, sizeof(float) * 2 * cmd->numVertices);
+				memcpy(colors, cmd->colors, sizeof(uint32_t) * cmd->numVertices);
+				memcpy(darkColors, cmd->darkColors, sizeof(uint32_t) * cmd->numVertices);
+				for (int iii = 0; iii < cmd->numIndices; iii++)
+					indices[iii] = (uint16_t) (cmd->indices[iii] + indicesOffset);
+				indicesOffset += cmd->numVertices;
+				positions += 2 * cmd->numVertices;
+				uvs += 2 * cmd->numVertices;
+				colors += cmd->numVertices;
+				darkColors += cmd->numVertices;
+				indices += cmd->numIndices;
+			}
+		}
+		batched->next = nullptr;
+
+		if (!last) root = last = batched;
+		else {
+			last->next = batched;
+			last = batched;
+		}
+		_stats.drawCalls++;
+		_stats.vertices += numVertices;
+		_stats.indices += numIndices;
+		i = runEnd;
+	}
+	return root;
+}
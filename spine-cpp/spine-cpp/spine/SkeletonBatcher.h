@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonBatcher_h
+#define Spine_SkeletonBatcher_h
+
+#include <spine/SkeletonRenderer.h>
+
+namespace spine {
+	class Skeleton;
+
+	struct SP_API SkeletonBatcherStats {
+		/// Number of skeletons added since begin().
+		int skeletons;
+		/// Number of commands produced by the per skeleton SkeletonRenderer before merging across skeletons.
+		int inputCommands;
+		/// Number of commands returned by end(), i.e. the number of draw calls a backend has to issue.
+		int drawCalls;
+		int vertices;
+		int indices;
+		/// Wall clock time spent in add() and end() for the current frame, in milliseconds.
+		double cpuTimeMs;
+	};
+
+	/// Renders many skeletons into a single list of render commands. Each skeleton is rendered through a
+	/// SkeletonRenderer, its positions are transformed by an optional 2x3 affine matrix, and consecutive
+	/// commands sharing texture and blend mode are merged across skeleton boundaries.
+	///
+	/// Skeletons are drawn in ascending layer order. Within a layer skeletons keep their submission order,
+	/// unless reordering is enabled, in which case a skeleton may be moved back next to an earlier skeleton
+	/// ending with the same texture and blend mode, provided its bounds do not overlap any skeleton it is moved
+	/// in front of.
+	///
+	/// The returned commands stay valid until the next call to begin().
+	class SP_API SkeletonBatcher : public SpineObject {
+	public:
+		SkeletonBatcher();
+
+		~SkeletonBatcher();
+
+		void begin();
+
+		/// @param layer Skeletons with a lower layer are drawn first.
+		/// @param transform A 2x3 affine matrix {a, b, c, d, tx, ty} mapping skeleton space to batch space as
+		/// x' = a * x + b * y + tx, y' = c * x + d * y + ty. NULL for identity.
+		void add(Skeleton &skeleton, int layer = 0, const float *transform = NULL);
+
+		RenderCommand *end();
+
+		/// Statistics of the last begin()/end() cycle.
+		const SkeletonBatcherStats &getStats();
+
+		bool getReorder();
+
+		void setReorder(bool inValue);
+
+	private:
+		struct Item {
+			int layer;
+			int order;
+			RenderCommand *first;
+			RenderCommand *last;
+			float minX, minY, maxX, maxY;
+		};
+
+		SkeletonRenderer _renderer;
+		BlockAllocator _allocator;
+		Vector<Item> _items;
+		Vector<int> _sorted;
+		Vector<int> _placed;
+		Vector<RenderCommand *> _commands;
+		SkeletonBatcherStats _stats;
+		bool _reorder;
+
+		void sortItems();
+
+		void placeLayer(int start, int end);
+
+		RenderCommand *mergeCommands();
+	};
+}
+
+#endif /* Spine_SkeletonBatcher_h */
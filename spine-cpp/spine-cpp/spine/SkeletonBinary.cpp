@@ -30,6 +30,7 @@
 #include <spine/SkeletonBinary.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
@@ -68,45 +69,134 @@
 #include <spine/ScaleTimeline.h>
 #include <spine/ShearTimeline.h>
 #include <spine/SlotData.h>
+#include <spine/TaskScheduler.h>
 #include <spine/TransformConstraintData.h>
 #include <spine/TransformConstraintTimeline.h>
 #include <spine/TranslateTimeline.h>
 #include <spine/SequenceTimeline.h>
 #include <spine/Version.h>
 
+#include <stdint.h>
+
 using namespace spine;
 
+/* The binary format is big endian. Assembling a word from its bytes lets the compiler use a single load and byte swap
+ * rather than four dependent byte reads. */
+static inline unsigned int readBigEndian(const unsigned char *bytes) {
+	return ((unsigned int) bytes[0] << 24) | ((unsigned int) bytes[1] << 16) | ((unsigned int) bytes[2] << 8) |
+		   (unsigned int) bytes[3];
+}
+
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _ownsLoader(true), _taskScheduler(NULL),
+													_ownsTaskScheduler(false), _lazyAnimations(false), _useArena(false) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
-																					  _ownsLoader(ownsLoader) {
+																					  _ownsLoader(ownsLoader),
+																					  _taskScheduler(NULL),
+																					  _ownsTaskScheduler(false),
+																					  _lazyAnimations(false),
+																					  _useArena(false) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale) : _attachmentLoader(NULL), _error(), _scale(scale), _ownsLoader(false),
+											  _taskScheduler(NULL), _ownsTaskScheduler(false), _lazyAnimations(false),
+											  _useArena(false) {
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
 
 	if (_ownsLoader) delete _attachmentLoader;
+	if (_ownsTaskScheduler) delete _taskScheduler;
 }
 
-SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length) {
-	bool nonessential;
-	SkeletonData *skeletonData;
+void SkeletonBinary::setTaskScheduler(TaskScheduler *taskScheduler) {
+	if (_ownsTaskScheduler) delete _taskScheduler;
+	_taskScheduler = taskScheduler;
+	_ownsTaskScheduler = false;
+}
+
+void SkeletonBinary::setThreadCount(int threadCount) {
+	setTaskScheduler(threadCount > 1 ? new (__FILE__, __LINE__) ThreadTaskScheduler(threadCount) : NULL);
+	_ownsTaskScheduler = _taskScheduler != NULL;
+}
+
+namespace {
+	struct ReadAnimationsTask {
+		SkeletonBinary *loader;
+		SkeletonData *skeletonData;
+		DataArena *arena;
+		Vector<String> names;
+		Vector<const unsigned char *> starts;
+		Vector<String> errors;
+	};
+}
+
+namespace spine {
+	/// Decodes animations from a copy of their bytes.
+	class BinaryAnimationDecoder : public AnimationDecoder {
+	public:
+		BinaryAnimationDecoder(float scale, const unsigned char *start, Vector<size_t> &offsets) : _binary(scale),
+																									 _offsets(offsets) {
+			size_t length = offsets[offsets.size() - 1];
+			_bytes.setSize(length, 0);
+			memcpy(_bytes.buffer(), start, length);
+		}
+
+		virtual ~BinaryAnimationDecoder() {
+			waitForPrefetch();
+		}
+
+	protected:
+		virtual Animation *decode(SkeletonData *skeletonData, int index, String &error) override {
+			SkeletonBinary::DataInput input;
+			input.cursor = _bytes.buffer() + _offsets[index];
+			input.end = _bytes.buffer() + _offsets[index + 1];
+			return _binary.readAnimation(skeletonData->getAnimations()[index]->getName(), &input, skeletonData, error);
+		}
+
+	private:
+		SkeletonBinary _binary;
+		Vector<unsigned char> _bytes;
+		Vector<size_t> _offsets;
+	};
+}
 
-	DataInput *input = new (__FILE__, __LINE__) DataInput();
-	input->cursor = binary;
-	input->end = binary + length;
+void SkeletonBinary::readAnimationTask(int index, void *userData) {
+	ReadAnimationsTask *task = (ReadAnimationsTask *) userData;
+	DataArena::Scope arena(task->arena);
+	DataInput input;
+	input.cursor = task->starts[index];
+	input.end = task->starts[index + 1];
+	task->skeletonData->_animations[index] = task->loader->readAnimation(task->names[index], &input,
+																			task->skeletonData, task->errors[index]);
+}
+
+SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length) {
+	DataInput input;
+	input.cursor = binary;
+	input.end = binary + length;
 
 	_linkedMeshes.clear();
 
-	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	SkeletonData *skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	if (readSkeletonData(&input, skeletonData)) return skeletonData;
+	delete skeletonData;
+	return NULL;
+}
+
+bool SkeletonBinary::readSkeletonData(DataInput *input, SkeletonData *skeletonData) {
+	bool nonessential;
+
+	DataArena::Scope arena(_useArena ? &skeletonData->getArena() : NULL);
 
 	char buffer[16] = {0};
 	int lowHash = readInt(input);
@@ -125,9 +215,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		char errorMsg[255];
 		snprintf(errorMsg, 255, "Skeleton version %s does not match runtime version %s", skeletonData->_version.buffer(), SPINE_VERSION_STRING);
 		setError(errorMsg, "");
-		delete input;
-		delete skeletonData;
-		return NULL;
+		return false;
 	}
 
 	skeletonData->_x = readFloat(input);
@@ -190,7 +278,7 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 			slotData->getDarkColor().set(r / 255.0f, g / 255.0f, b / 255.0f, 1);
 			slotData->setHasDarkColor(true);
 		}
-		slotData->_attachmentName = readStringRef(input, skeletonData);
+		slotData->_attachmentName = String::atom(readStringRef(input, skeletonData));
 		slotData->_blendMode = static_cast<BlendMode>(readVarint(input, true));
 		if (nonessential) {
 			slotData->_visible = readBoolean(input);
@@ -326,22 +414,15 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		skeletonData->_skins.add(defaultSkin);
 	}
 
-	if (!this->getError().isEmpty()) {
-		delete input;
-		delete skeletonData;
-		return NULL;
-	}
+	if (!this->getError().isEmpty()) return false;
 
 	/* Skins. */
 	for (size_t i = 0, n = (size_t) readVarint(input, true); i < n; ++i) {
 		Skin *skin = readSkin(input, false, skeletonData, nonessential);
 		if (skin)
 			skeletonData->_skins.add(skin);
-		else {
-			delete input;
-			delete skeletonData;
-			return NULL;
-		}
+		else
+			return false;
 	}
 
 	/* Linked meshes. */
@@ -350,10 +431,8 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		Skin *skin = skeletonData->_skins[linkedMesh->_skinIndex];
 		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
 		if (parent == NULL) {
-			delete input;
-			delete skeletonData;
 			setError("Parent mesh not found: ", linkedMesh->_parent.buffer());
-			return NULL;
+			return false;
 		}
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
@@ -380,35 +459,81 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		}
 		skeletonData->_events[i] = eventData;
 	}
+	skeletonData->updateIndices();
 
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
-	for (int i = 0; i < animationsCount; ++i) {
-		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
-		if (!animation) {
-			delete input;
-			delete skeletonData;
-			return NULL;
+	int animationsIndex = 0;
+	if (_lazyAnimations && animationsCount > 0) {
+		/* Create empty animations and keep a copy of the bytes of each for the decoder. */
+		const unsigned char *start = input->cursor;
+		Vector<size_t> offsets;
+		offsets.ensureCapacity(animationsCount + 1);
+		for (; animationsIndex < animationsCount; ++animationsIndex) {
+			String name(readString(input), true);
+			offsets.add(input->cursor - start);
+			Vector<Timeline *> timelines;
+			skeletonData->_animations[animationsIndex] = new (__FILE__, __LINE__) Animation(name, timelines, 0);
+			if (!skipAnimation(input, skeletonData)) {
+				setError("Error reading animation: ", name.buffer());
+				return false;
+			}
+		}
+		offsets.add(input->cursor - start);
+		skeletonData->setAnimationDecoder(new (__FILE__, __LINE__) BinaryAnimationDecoder(_scale, start, offsets));
+	} else if (_taskScheduler && animationsCount > 1) {
+		/* Animations aren't length prefixed, so find where each one starts with a quick scan, then decode them
+		 * concurrently. Errors are kept per animation and the first one in file order is reported. */
+		ReadAnimationsTask task;
+		task.loader = this;
+		task.skeletonData = skeletonData;
+		task.arena = DataArena::getCurrent();
+		task.names.ensureCapacity(animationsCount);
+		task.starts.ensureCapacity(animationsCount + 1);
+		for (; animationsIndex < animationsCount; ++animationsIndex) {
+			const unsigned char *start = input->cursor;
+			String name(readString(input), true);
+			const unsigned char *animationStart = input->cursor;
+			if (!skipAnimation(input, skeletonData)) {
+				/* Decode the malformed animation serially below so it reports its own error. */
+				input->cursor = start;
+				break;
+			}
+			task.names.add(name);
+			task.starts.add(animationStart);
+		}
+		task.starts.add(input->cursor);
+		task.errors.setSize(animationsIndex, String());
+		_taskScheduler->parallelFor(animationsIndex, readAnimationTask, &task);
+		for (int i = 0; i < animationsIndex; ++i) {
+			if (!skeletonData->_animations[i]) {
+				setError(_error, task.errors[i].buffer(), NULL);
+				return false;
+			}
 		}
-		skeletonData->_animations[i] = animation;
+	}
+	for (; animationsIndex < animationsCount; ++animationsIndex) {
+		String name(readString(input), true);
+		Animation *animation = readAnimation(name, input, skeletonData, _error);
+		if (!animation) return false;
+		skeletonData->_animations[animationsIndex] = animation;
 	}
 
-	delete input;
-	return skeletonData;
+	skeletonData->updateIndices();
+	return true;
 }
 
 SkeletonData *SkeletonBinary::readSkeletonDataFile(const String &path) {
-	int length;
+	MappedFile file;
 	SkeletonData *skeletonData;
-	const char *binary = SpineExtension::readFile(path.buffer(), &length);
-	if (length == 0 || !binary) {
+	if (!SpineExtension::mapFile(path, file) || file.length == 0) {
+		SpineExtension::unmapFile(file);
 		setError("Unable to read skeleton file: ", path.buffer());
 		return NULL;
 	}
-	skeletonData = readSkeletonData((unsigned char *) binary, length);
-	SpineExtension::free(binary, __FILE__, __LINE__);
+	skeletonData = readSkeletonData((const unsigned char *) file.data, file.length);
+	SpineExtension::unmapFile(file);
 	return skeletonData;
 }
 
@@ -418,9 +543,17 @@ void SkeletonBinary::setError(const char *value1, const char *value2) {
 	strcpy(message, value1);
 	length = (int) strlen(value1);
 	if (value2) strncat(message + length, value2, 255 - length);
+	/* Errors outlive the skeleton data, which is deleted when reading fails. */
+	DataArena::Scope heap(NULL);
 	_error = String(message);
 }
 
+void SkeletonBinary::setError(String &error, const char *value1, const char *value2) {
+	DataArena::Scope heap(NULL);
+	error = String(value1);
+	if (value2) error.append(value2);
+}
+
 char *SkeletonBinary::readString(DataInput *input) {
 	int length = readVarint(input, true);
 	char *string;
@@ -459,13 +592,8 @@ bool SkeletonBinary::readBoolean(DataInput *input) {
 }
 
 int SkeletonBinary::readInt(DataInput *input) {
-	int result = readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
-	result <<= 8;
-	result |= readByte(input);
+	int result = (int) readBigEndian(input->cursor);
+	input->cursor += 4;
 	return result;
 }
 
@@ -543,7 +671,7 @@ Skin *SkeletonBinary::readSkin(DataInput *input, bool defaultSkin, SkeletonData
 	for (int i = 0; i < slotCount; ++i) {
 		int slotIndex = readVarint(input, true);
 		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
-			String name(readStringRef(input, skeletonData));
+			String name = String::atom(readStringRef(input, skeletonData));
 			Attachment *attachment = readAttachment(input, skin, slotIndex, name, skeletonData, nonessential);
 			if (attachment)
 				skin->setAttachment(slotIndex, String(name), attachment);
@@ -691,6 +819,8 @@ Attachment *SkeletonBinary::readAttachment(DataInput *input, Skin *skin, int slo
 				mesh->_height = height;
 			}
 
+			/* Linked meshes belong to the loader, so they are never put in the skeleton data's arena. */
+			DataArena::Scope heap(NULL);
 			LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh, skinIndex, slotIndex,
 																		 String(parent), inheritTimelines);
 			_linkedMeshes.add(linkedMesh);
@@ -778,24 +908,58 @@ int SkeletonBinary::readVertices(DataInput *input, Vector<float> &vertices, Vect
 
 void SkeletonBinary::readFloatArray(DataInput *input, int n, float scale, Vector<float> &array) {
 	array.setSize(n, 0);
+	readFloats(input, array.buffer(), n, scale);
+}
 
-	int i;
-	if (scale == 1) {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input);
-		}
-	} else {
-		for (i = 0; i < n; ++i) {
-			array[i] = readFloat(input) * scale;
-		}
+void SkeletonBinary::readFloats(DataInput *input, float *values, int n, float scale) {
+	/* Swap whole words straight into the destination, then scale in a separate pass so both loops vectorize. */
+	const unsigned char *bytes = input->cursor;
+	for (int i = 0; i < n; ++i) {
+		unsigned int bits = readBigEndian(bytes + (i << 2));
+		memcpy(values + i, &bits, 4);
+	}
+	input->cursor += n << 2;
+	if (scale != 1) {
+		for (int i = 0; i < n; ++i)
+			values[i] *= scale;
 	}
 }
 
 void SkeletonBinary::readShortArray(DataInput *input, Vector<unsigned short> &array, int n) {
 	array.setSize(n, 0);
-	for (int i = 0; i < n; ++i) {
-		array[i] = (short) readVarint(input, true);
+	unsigned short *values = array.buffer();
+	const unsigned char *cursor = input->cursor, *end = input->end;
+	int i = 0;
+	while (i < n) {
+		/* Small indices fit in one byte, so runs of them are checked eight at a time for continuation bits. */
+		if (*cursor < 0x80 && n - i >= 8 && end - cursor >= 8) {
+			uint64_t bytes;
+			memcpy(&bytes, cursor, 8);
+			if ((bytes & 0x8080808080808080ULL) == 0) {
+				for (int ii = 0; ii < 8; ++ii)
+					values[i + ii] = cursor[ii];
+				cursor += 8;
+				i += 8;
+				continue;
+			}
+		}
+		unsigned int b = *cursor;
+		if (b < 0x80) {
+			values[i++] = (unsigned short) b;
+			cursor++;
+		} else if (cursor[1] < 0x80) {
+			values[i++] = (unsigned short) ((b & 0x7F) | (cursor[1] << 7));
+			cursor += 2;
+		} else if (cursor[2] < 0x80) {
+			values[i++] = (unsigned short) ((b & 0x7F) | ((cursor[1] & 0x7F) << 7) | (cursor[2] << 14));
+			cursor += 3;
+		} else {
+			input->cursor = cursor;
+			values[i++] = (unsigned short) readVarint(input, true);
+			cursor = input->cursor;
+		}
 	}
+	input->cursor = cursor;
 }
 
 void SkeletonBinary::setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1,
@@ -854,11 +1018,12 @@ void SkeletonBinary::readTimeline2(DataInput *input, Vector<Timeline *> &timelin
 	timelines.add(timeline);
 }
 
-Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData) {
+Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData,
+										 String &error) {
 	Vector<Timeline *> timelines;
 	float scale = _scale;
 	int numTimelines = readVarint(input, true);
-	SP_UNUSED(numTimelines);
+	timelines.ensureCapacity(numTimelines);
 	// Slot timelines.
 	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
 		int slotIndex = readVarint(input, true);
@@ -871,8 +1036,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 					AttachmentTimeline *timeline = new (__FILE__, __LINE__) AttachmentTimeline(frameCount, slotIndex);
 					for (int frame = 0; frame < frameCount; ++frame) {
 						float time = readFloat(input);
-						String attachmentName(readStringRef(input, skeletonData));
-						timeline->setFrame(frame, time, attachmentName);
+						timeline->setFrame(frame, time, String::atom(readStringRef(input, skeletonData)));
 					}
 					timelines.add(timeline);
 					break;
@@ -1072,7 +1236,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				}
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+					setError(error, "Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
 					return NULL;
 				}
 			}
@@ -1143,7 +1307,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 					break;
 				default: {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+					setError(error, "Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
 					return NULL;
 				}
 			}
@@ -1332,7 +1496,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				Attachment *baseAttachment = skin->getAttachment(slotIndex, String(attachmentName));
 				if (!baseAttachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError("Attachment not found: ", attachmentName);
+					setError(error, "Attachment not found: ", attachmentName);
 					return NULL;
 				}
 				unsigned int timelineType = readByte(input);
@@ -1366,13 +1530,7 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 								deform.setSize(deformLength, 0);
 								size_t start = (size_t) readVarint(input, true);
 								end += start;
-								if (scale == 1) {
-									for (size_t v = start; v < end; ++v)
-										deform[v] = readFloat(input);
-								} else {
-									for (size_t v = start; v < end; ++v)
-										deform[v] = readFloat(input) * scale;
-								}
+								readFloats(input, deform.buffer() + start, (int) (end - start), scale);
 
 								if (!weighted) {
 									for (size_t v = 0, vn = deform.size(); v < vn; ++v)
@@ -1488,3 +1646,185 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 	}
 	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
 }
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData) {
+	readVarint(input, true);
+
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					input->cursor += 4;
+					readVarint(input, true);
+				}
+				continue;
+			}
+			readVarint(input, true);
+			switch (timelineType) {
+				case SLOT_RGBA:
+					skipCurves(input, frameCount, 4, 4);
+					break;
+				case SLOT_RGB:
+					skipCurves(input, frameCount, 3, 3);
+					break;
+				case SLOT_RGBA2:
+					skipCurves(input, frameCount, 7, 7);
+					break;
+				case SLOT_RGB2:
+					skipCurves(input, frameCount, 6, 6);
+					break;
+				case SLOT_ALPHA:
+					skipCurves(input, frameCount, 1, 1);
+					break;
+				default:
+					return false;
+			}
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == BONE_INHERIT) {
+				input->cursor += frameCount * 5;
+				continue;
+			}
+			readVarint(input, true);
+			switch (timelineType) {
+				case BONE_ROTATE:
+				case BONE_TRANSLATEX:
+				case BONE_TRANSLATEY:
+				case BONE_SCALEX:
+				case BONE_SCALEY:
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					skipCurves(input, frameCount, 4, 1);
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					skipCurves(input, frameCount, 8, 2);
+					break;
+				default:
+					return false;
+			}
+		}
+	}
+
+	// IK timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		for (int frame = 0; frame < frameCount; ++frame) {
+			int flags = readByte(input);
+			input->cursor += 4;
+			if ((flags & 1) != 0 && (flags & 2) != 0) input->cursor += 4;
+			if ((flags & 4) != 0) input->cursor += 4;
+			if (frame > 0 && (flags & 64) == 0 && (flags & 128) != 0) input->cursor += 32;
+		}
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipCurves(input, frameCount, 24, 6);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			if (type == PATH_MIX)
+				skipCurves(input, frameCount, 12, 3);
+			else
+				skipCurves(input, frameCount, 4, 1);
+		}
+	}
+
+	// Physics timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; i++) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int type = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (type == PHYSICS_RESET) {
+				input->cursor += frameCount * 4;
+				continue;
+			}
+			readVarint(input, true);
+			skipCurves(input, frameCount, 4, 1);
+		}
+	}
+
+	// Attachment timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				readVarint(input, true);
+				unsigned int timelineType = readByte(input);
+				int frameCount = readVarint(input, true);
+				if (timelineType == ATTACHMENT_SEQUENCE) {
+					input->cursor += frameCount * 12;
+					continue;
+				}
+				readVarint(input, true);
+				input->cursor += 4;
+				for (int frame = 0; frame < frameCount; ++frame) {
+					int end = readVarint(input, true);
+					if (end != 0) {
+						readVarint(input, true);
+						input->cursor += end * 4;
+					}
+					if (frame == frameCount - 1) break;
+					input->cursor += 4;
+					if (readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+				}
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		input->cursor += 4;
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		input->cursor += 4;
+		int length = readVarint(input, true);
+		if (length > 0) input->cursor += length - 1;
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
+	}
+	return input->cursor <= input->end;
+}
+
+void SkeletonBinary::skipCurves(DataInput *input, int frameCount, int valueSize, int channels) {
+	if (frameCount == 0) return;
+	input->cursor += 4 + valueSize;
+	for (int frame = 1; frame < frameCount; ++frame) {
+		input->cursor += 4 + valueSize;
+		if (readSByte(input) == CURVE_BEZIER) input->cursor += channels * 16;
+	}
+}
@@ -63,7 +63,13 @@ namespace spine {
 
 	class Sequence;
 
+	class TaskScheduler;
+
+	class BinaryAnimationDecoder;
+
 	class SP_API SkeletonBinary : public SpineObject {
+		friend class BinaryAnimationDecoder;
+
 	public:
 		static const int BONE_ROTATE = 0;
 		static const int BONE_TRANSLATE = 1;
@@ -116,6 +122,25 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// Decodes animations in parallel using the given scheduler, or serially if NULL. The scheduler is not
+		/// owned and must outlive this loader.
+		void setTaskScheduler(TaskScheduler *taskScheduler);
+
+		/// Decodes animations in parallel on the given number of threads, or serially if 1 or less.
+		void setThreadCount(int threadCount);
+
+		/// When true, animations are not decoded when the skeleton data is read. Their bytes are kept and each
+		/// animation is decoded the first time it is needed, see SkeletonData::getAnimationDecoder().
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
+		/// When true, the bones, slots, skins, attachments, animations and all other objects of the skeleton data are
+		/// allocated from its arena, see SkeletonData::getArena(). Timelines are then laid out next to each other and
+		/// destroying the objects doesn't free their memory one by one. The attachment loader must not keep memory it
+		/// allocates while reading.
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		bool getUseArena() { return _useArena; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -129,9 +154,23 @@ namespace spine {
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		TaskScheduler *_taskScheduler;
+		bool _ownsTaskScheduler;
+		bool _lazyAnimations;
+		bool _useArena;
+
+		explicit SkeletonBinary(float scale);
+
+		static void readAnimationTask(int index, void *userData);
+
+		/// Reads into the skeleton data while its arena is installed. On failure the caller deletes the skeleton data
+		/// after this returns, when the locals allocated from the arena are gone.
+		bool readSkeletonData(DataInput *input, SkeletonData *skeletonData);
 
 		void setError(const char *value1, const char *value2);
 
+		static void setError(String &error, const char *value1, const char *value2);
+
 		char *readString(DataInput *input);
 
 		char *readStringRef(DataInput *input, SkeletonData *skeletonData);
@@ -161,9 +200,15 @@ namespace spine {
 
 		void readFloatArray(DataInput *input, int n, float scale, Vector<float> &array);
 
+		static void readFloats(DataInput *input, float *values, int n, float scale);
+
 		void readShortArray(DataInput *input, Vector<unsigned short> &array, int n);
 
-		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData);
+		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData, String &error);
+
+		bool skipAnimation(DataInput *input, SkeletonData *skeletonData);
+
+		void skipCurves(DataInput *input, int frameCount, int valueSize, int channels);
 
 		void
 		setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1, float time2,
@@ -34,13 +34,20 @@
 
 using namespace spine;
 
-SkeletonClipping::SkeletonClipping() : _clipAttachment(NULL) {
+static const size_t MAX_CACHED_DECOMPOSITIONS = 8;
+
+SkeletonClipping::SkeletonClipping() : _nextCacheEntry(0), _clipAttachment(NULL), _clippingPolygons(NULL), _clipRectangle(false) {
 	_clipOutput.ensureCapacity(128);
 	_clippedVertices.ensureCapacity(128);
 	_clippedTriangles.ensureCapacity(128);
 	_clippedUVs.ensureCapacity(128);
 }
 
+SkeletonClipping::~SkeletonClipping() {
+	ContainerUtil::cleanUpVectorOfPointers(_decompositionCache);
+	ContainerUtil::cleanUpVectorOfPointers(_polygonPool);
+}
+
 size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 	if (_clipAttachment != NULL) {
 		return 0;
@@ -51,8 +58,42 @@ size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 	int n = (int) clip->getWorldVerticesLength();
 	_clippingPolygon.setSize(n, 0);
 	clip->computeWorldVertices(slot, 0, n, _clippingPolygon, 0, 2);
-	makeClockwise(_clippingPolygon);
-	_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
+
+	if (clip->getBones().size() > 0) {
+		// Weighted vertices don't have a single local space to cache the decomposition in.
+		makeClockwise(_clippingPolygon);
+		_clippingPolygons = &_triangulator.decompose(_clippingPolygon, _triangulator.triangulate(_clippingPolygon));
+	} else {
+		// The bone transform is affine, so the local space decomposition indexes the world polygon too.
+		DecompositionCache &cache = getDecomposition(slot, clip);
+		if (cache.reversed) {
+			for (int i = 0, lastX = n - 2, nn = n >> 1; i < nn; i += 2) {
+				float x = _clippingPolygon[i], y = _clippingPolygon[i + 1];
+				_clippingPolygon[i] = _clippingPolygon[lastX - i];
+				_clippingPolygon[i + 1] = _clippingPolygon[lastX - i + 1];
+				_clippingPolygon[lastX - i] = x;
+				_clippingPolygon[lastX - i + 1] = y;
+			}
+		}
+
+		size_t polygonsCount = cache.polygonSizes.size();
+		while (_polygonPool.size() < polygonsCount)
+			_polygonPool.add(new (__FILE__, __LINE__) Vector<float>());
+		_polygons.clear();
+		int *indices = cache.polygonIndices.buffer();
+		for (size_t i = 0; i < polygonsCount; i++) {
+			Vector<float> &polygon = *_polygonPool[i];
+			_polygons.add(&polygon);
+			int size = cache.polygonSizes[i];
+			polygon.setSize(size << 1, 0);
+			for (int ii = 0; ii < size; ii++) {
+				polygon[ii << 1] = _clippingPolygon[indices[ii]];
+				polygon[(ii << 1) + 1] = _clippingPolygon[indices[ii] + 1];
+			}
+			indices += size;
+		}
+		_clippingPolygons = &_polygons;
+	}
 
 	for (size_t i = 0; i < _clippingPolygons->size(); ++i) {
 		Vector<float> *polygonP = (*_clippingPolygons)[i];
@@ -61,6 +102,7 @@ size_t SkeletonClipping::clipStart(Slot &slot, ClippingAttachment *clip) {
 		polygon.add(polygon[0]);
 		polygon.add(polygon[1]);
 	}
+	computeBounds();
 
 	return (*_clippingPolygons).size();
 }
@@ -76,6 +118,7 @@ void SkeletonClipping::clipEnd() {
 
 	_clipAttachment = NULL;
 	_clippingPolygons = NULL;
+	_clipRectangle = false;
 	_clippedVertices.clear();
 	_clippedUVs.clear();
 	_clippedTriangles.clear();
@@ -87,7 +130,6 @@ void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 	Vector<float> &clipOutput = _clipOutput;
 	Vector<float> &clippedVertices = _clippedVertices;
 	Vector<unsigned short> &clippedTriangles = _clippedTriangles;
-	Vector<Vector<float> *> &polygons = *_clippingPolygons;
 	size_t polygonsCount = (*_clippingPolygons).size();
 
 	size_t index = 0;
@@ -110,7 +152,7 @@ continue_outer:
 
 		for (size_t p = 0; p < polygonsCount; p++) {
 			size_t s = clippedVertices.size();
-			if (clip(x1, y1, x2, y2, x3, y3, &(*polygons[p]), &clipOutput)) {
+			if (clipTriangle(x1, y1, x2, y2, x3, y3, p, &clipOutput)) {
 				size_t clipOutputLength = clipOutput.size();
 				if (clipOutputLength == 0) continue;
 
@@ -165,7 +207,6 @@ void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 	Vector<float> &clipOutput = _clipOutput;
 	Vector<float> &clippedVertices = _clippedVertices;
 	Vector<unsigned short> &clippedTriangles = _clippedTriangles;
-	Vector<Vector<float> *> &polygons = *_clippingPolygons;
 	size_t polygonsCount = (*_clippingPolygons).size();
 
 	size_t index = 0;
@@ -190,7 +231,7 @@ continue_outer:
 
 		for (size_t p = 0; p < polygonsCount; p++) {
 			size_t s = clippedVertices.size();
-			if (clip(x1, y1, x2, y2, x3, y3, &(*polygons[p]), &clipOutput)) {
+			if (clipTriangle(x1, y1, x2, y2, x3, y3, p, &clipOutput)) {
 				size_t clipOutputLength = clipOutput.size();
 				if (clipOutputLength == 0) continue;
 				float d0 = y2 - y3, d1 = x3 - x2, d2 = x1 - x3, d4 = y3 - y1;
@@ -268,6 +309,127 @@ Vector<float> &SkeletonClipping::getClippedUVs() {
 	return _clippedUVs;
 }
 
+void SkeletonClipping::computeBounds() {
+	Vector<Vector<float> *> &polygons = *_clippingPolygons;
+	_clippingPolygonBounds.setSize(polygons.size() * 4, 0);
+	for (size_t i = 0, n = polygons.size(); i < n; i++) {
+		Vector<float> &polygon = *polygons[i];
+		float minX = polygon[0], minY = polygon[1], maxX = minX, maxY = minY;
+		for (size_t ii = 2, nn = polygon.size(); ii < nn; ii += 2) {
+			float x = polygon[ii], y = polygon[ii + 1];
+			minX = MathUtil::min(minX, x);
+			minY = MathUtil::min(minY, y);
+			maxX = MathUtil::max(maxX, x);
+			maxY = MathUtil::max(maxY, y);
+		}
+		_clippingPolygonBounds[i * 4] = minX;
+		_clippingPolygonBounds[i * 4 + 1] = minY;
+		_clippingPolygonBounds[i * 4 + 2] = maxX;
+		_clippingPolygonBounds[i * 4 + 3] = maxY;
+	}
+
+	// A clipping polygon that is a (possibly rotated) rectangle is clipped against in its local space.
+	_clipRectangle = false;
+	if (polygons.size() != 1 || polygons[0]->size() != 10) return;
+	float *r = polygons[0]->buffer();
+	float ux = r[2] - r[0], uy = r[3] - r[1], vx = r[6] - r[0], vy = r[7] - r[1];
+	float width = MathUtil::sqrt(ux * ux + uy * uy), height = MathUtil::sqrt(vx * vx + vy * vy);
+	if (width == 0 || height == 0) return;
+	float epsilon = 0.0001f * (width + height);
+	if (MathUtil::abs(r[0] + ux + vx - r[4]) > epsilon || MathUtil::abs(r[1] + uy + vy - r[5]) > epsilon) return;
+	if (MathUtil::abs(ux * vx + uy * vy) > 0.0001f * width * height) return;
+	_rectangle[0] = r[0];
+	_rectangle[1] = r[1];
+	_rectangle[2] = ux / width;
+	_rectangle[3] = uy / width;
+	_rectangle[4] = vx / height;
+	_rectangle[5] = vy / height;
+	_rectangle[6] = width;
+	_rectangle[7] = height;
+	_clipRectangle = true;
+}
+
+bool SkeletonClipping::clipTriangle(float x1, float y1, float x2, float y2, float x3, float y3, size_t polygonIndex,
+									Vector<float> *output) {
+	if (_clipRectangle) return clipRectangle(x1, y1, x2, y2, x3, y3, output);
+
+	float *bounds = &_clippingPolygonBounds[polygonIndex * 4];
+	if (MathUtil::max(x1, MathUtil::max(x2, x3)) < bounds[0] || MathUtil::max(y1, MathUtil::max(y2, y3)) < bounds[1] ||
+		MathUtil::min(x1, MathUtil::min(x2, x3)) > bounds[2] || MathUtil::min(y1, MathUtil::min(y2, y3)) > bounds[3]) {
+		output->clear();
+		return true;
+	}
+
+	// Same inside test as clip(), all three vertices must be strictly inside every edge.
+	Vector<float> &polygon = *(*_clippingPolygons)[polygonIndex];
+	for (size_t i = 0, n = polygon.size() - 2; i < n; i += 2) {
+		float edgeX = polygon[i], edgeY = polygon[i + 1];
+		float ex = edgeX - polygon[i + 2], ey = edgeY - polygon[i + 3];
+		if (ey * (edgeX - x1) - ex * (edgeY - y1) <= 0 || ey * (edgeX - x2) - ex * (edgeY - y2) <= 0 ||
+			ey * (edgeX - x3) - ex * (edgeY - y3) <= 0)
+			return clip(x1, y1, x2, y2, x3, y3, &polygon, output);
+	}
+	return false;
+}
+
+/// Clips the polygon in input against the half plane where coordinate axis is >= bound (or <= bound when keepBelow is
+/// set), returning the number of output vertices.
+static int clipAxis(const float *input, int count, float *output, int axis, float bound, bool keepBelow) {
+	int outputCount = 0;
+	for (int i = 0; i < count; i++) {
+		const float *v1 = input + i * 2, *v2 = input + ((i + 1) % count) * 2;
+		float d1 = keepBelow ? bound - v1[axis] : v1[axis] - bound;
+		float d2 = keepBelow ? bound - v2[axis] : v2[axis] - bound;
+		if (d1 >= 0) {
+			output[outputCount * 2] = v1[0];
+			output[outputCount * 2 + 1] = v1[1];
+			outputCount++;
+		}
+		if ((d1 >= 0) != (d2 >= 0)) {
+			float t = d1 / (d1 - d2);
+			output[outputCount * 2] = v1[0] + (v2[0] - v1[0]) * t;
+			output[outputCount * 2 + 1] = v1[1] + (v2[1] - v1[1]) * t;
+			outputCount++;
+		}
+	}
+	return outputCount;
+}
+
+bool SkeletonClipping::clipRectangle(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *output) {
+	float ox = _rectangle[0], oy = _rectangle[1], ux = _rectangle[2], uy = _rectangle[3], vx = _rectangle[4], vy = _rectangle[5];
+	float width = _rectangle[6], height = _rectangle[7];
+
+	// A triangle clipped by the 4 rectangle edges has at most 7 vertices.
+	float a[14], b[14];
+	a[0] = (x1 - ox) * ux + (y1 - oy) * uy;
+	a[1] = (x1 - ox) * vx + (y1 - oy) * vy;
+	a[2] = (x2 - ox) * ux + (y2 - oy) * uy;
+	a[3] = (x2 - ox) * vx + (y2 - oy) * vy;
+	a[4] = (x3 - ox) * ux + (y3 - oy) * uy;
+	a[5] = (x3 - ox) * vx + (y3 - oy) * vy;
+
+	float minU = MathUtil::min(a[0], MathUtil::min(a[2], a[4])), maxU = MathUtil::max(a[0], MathUtil::max(a[2], a[4]));
+	float minV = MathUtil::min(a[1], MathUtil::min(a[3], a[5])), maxV = MathUtil::max(a[1], MathUtil::max(a[3], a[5]));
+	if (minU > 0 && maxU < width && minV > 0 && maxV < height) return false;
+	output->clear();
+	if (maxU <= 0 || minU >= width || maxV <= 0 || minV >= height) return true;
+
+	int count = clipAxis(a, 3, b, 0, 0, false);
+	count = clipAxis(b, count, a, 0, width, true);
+	count = clipAxis(a, count, b, 1, 0, false);
+	count = clipAxis(b, count, a, 1, height, true);
+	if (count < 3) return true;
+
+	output->setSize(count * 2, 0);
+	float *vertices = output->buffer();
+	for (int i = 0; i < count; i++) {
+		float u = a[i * 2], v = a[i * 2 + 1];
+		vertices[i * 2] = ox + u * ux + v * vx;
+		vertices[i * 2 + 1] = oy + u * uy + v * vy;
+	}
+	return true;
+}
+
 bool SkeletonClipping::clip(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *clippingArea,
 							Vector<float> *output) {
 	Vector<float> *originalOutput = output;
@@ -370,7 +532,52 @@ bool SkeletonClipping::clip(float x1, float y1, float x2, float y2, float x3, fl
 	return clipped;
 }
 
-void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
+SkeletonClipping::DecompositionCache &SkeletonClipping::getDecomposition(Slot &slot, ClippingAttachment *clip) {
+	Vector<float> &deform = slot.getDeform();
+	float *vertices = deform.size() > 0 ? deform.buffer() : clip->getVertices().buffer();
+	size_t n = clip->getWorldVerticesLength();
+
+	DecompositionCache *cache = NULL;
+	for (size_t i = 0, nn = _decompositionCache.size(); i < nn; i++) {
+		if (_decompositionCache[i]->attachment == clip) {
+			cache = _decompositionCache[i];
+			break;
+		}
+	}
+	if (cache && cache->localVertices.size() == n && memcmp(cache->localVertices.buffer(), vertices, n * sizeof(float)) == 0)
+		return *cache;
+
+	if (!cache) {
+		if (_decompositionCache.size() < MAX_CACHED_DECOMPOSITIONS) {
+			cache = new (__FILE__, __LINE__) DecompositionCache();
+			_decompositionCache.add(cache);
+		} else {
+			cache = _decompositionCache[_nextCacheEntry];
+			_nextCacheEntry = (_nextCacheEntry + 1) % MAX_CACHED_DECOMPOSITIONS;
+		}
+		cache->attachment = clip;
+	}
+
+	Vector<float> &localVertices = cache->localVertices;
+	localVertices.setSize(n, 0);
+	memcpy(localVertices.buffer(), vertices, n * sizeof(float));
+
+	// Decompose a copy, makeClockwise() may reverse it.
+	Vector<float> &polygon = _scratch;
+	polygon.clearAndAddAll(localVertices);
+	cache->reversed = makeClockwise(polygon);
+	_triangulator.decompose(polygon, _triangulator.triangulate(polygon));
+	Vector<Vector<int> *> &polygonsIndices = _triangulator.getConvexPolygonsIndices();
+	cache->polygonIndices.clear();
+	cache->polygonSizes.clear();
+	for (size_t i = 0, nn = polygonsIndices.size(); i < nn; i++) {
+		cache->polygonIndices.addAll(*polygonsIndices[i]);
+		cache->polygonSizes.add((int) polygonsIndices[i]->size());
+	}
+	return *cache;
+}
+
+bool SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 	size_t verticeslength = polygon.size();
 
 	float area = polygon[verticeslength - 2] * polygon[1] - polygon[0] * polygon[verticeslength - 1];
@@ -384,7 +591,7 @@ void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 		area += p1x * p2y - p2x * p1y;
 	}
 
-	if (area < 0) return;
+	if (area < 0) return false;
 
 	for (size_t i = 0, lastX = verticeslength - 2, n = verticeslength >> 1; i < n; i += 2) {
 		float x = polygon[i], y = polygon[i + 1];
@@ -394,4 +601,5 @@ void SkeletonClipping::makeClockwise(Vector<float> &polygon) {
 		polygon[other] = x;
 		polygon[other + 1] = y;
 	}
+	return true;
 }
@@ -42,6 +42,8 @@ namespace spine {
 	public:
 		SkeletonClipping();
 
+		~SkeletonClipping();
+
 		size_t clipStart(Slot &slot, ClippingAttachment *clip);
 
 		void clipEnd(Slot &slot);
@@ -66,7 +68,21 @@ namespace spine {
 		Vector<float> &getClippedUVs();
 
 	private:
+		/** The convex decomposition of a clipping attachment's polygon, computed in the slot bone's local space. It stays
+		  * valid while the local vertices, i.e. the attachment's vertices or the slot's deform, are unchanged. */
+		struct DecompositionCache : public SpineObject {
+			ClippingAttachment *attachment;
+			Vector<float> localVertices;
+			bool reversed;
+			Vector<int> polygonIndices;
+			Vector<int> polygonSizes;
+		};
+
 		Triangulator _triangulator;
+		Vector<DecompositionCache *> _decompositionCache;
+		size_t _nextCacheEntry;
+		Vector<Vector<float> *> _polygonPool;
+		Vector<Vector<float> *> _polygons;
 		Vector<float> _clippingPolygon;
 		Vector<float> _clipOutput;
 		Vector<float> _clippedVertices;
@@ -75,13 +91,30 @@ namespace spine {
 		Vector<float> _scratch;
 		ClippingAttachment *_clipAttachment;
 		Vector<Vector<float> *> *_clippingPolygons;
+		Vector<float> _clippingPolygonBounds;
+		bool _clipRectangle;
+		float _rectangle[8];
+
+		/** Clips the input triangle against the convex polygon at the given index. Triangles whose bounds miss the polygon's
+		  * bounds are rejected and triangles with all vertices inside the polygon are accepted without running clip(). Returns
+		  * the same values as clip(). */
+		bool clipTriangle(float x1, float y1, float x2, float y2, float x3, float y3, size_t polygonIndex, Vector<float> *output);
+
+		/** Clips the input triangle against the rectangular clipping area described by _rectangle, using fixed size buffers
+		  * in the rectangle's local space. Returns the same values as clip(). */
+		bool clipRectangle(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *output);
+
+		void computeBounds();
 
 		/** Clips the input triangle against the convex, clockwise clipping area. If the triangle lies entirely within the clipping
 		  * area, false is returned. The clipping area must duplicate the first vertex at the end of the vertices list. */
 		bool clip(float x1, float y1, float x2, float y2, float x3, float y3, Vector<float> *clippingArea,
 				  Vector<float> *output);
 
-		static void makeClockwise(Vector<float> &polygon);
+		DecompositionCache &getDecomposition(Slot &slot, ClippingAttachment *clip);
+
+		/** Returns true if the polygon was reversed to make it clockwise. */
+		static bool makeClockwise(Vector<float> &polygon);
 	};
 }
 
@@ -30,6 +30,7 @@
 #include <spine/SkeletonData.h>
 
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/BoneData.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
@@ -45,6 +46,7 @@ using namespace spine;
 
 SkeletonData::SkeletonData() : _name(),
 							   _defaultSkin(NULL),
+							   _animationDecoder(NULL),
 							   _x(0),
 							   _y(0),
 							   _width(0),
@@ -64,6 +66,7 @@ SkeletonData::~SkeletonData() {
 	_defaultSkin = NULL;
 
 	ContainerUtil::cleanUpVectorOfPointers(_events);
+	delete _animationDecoder;
 	ContainerUtil::cleanUpVectorOfPointers(_animations);
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
@@ -75,39 +78,95 @@ SkeletonData::~SkeletonData() {
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
-	return ContainerUtil::findWithName(_bones, boneName);
+	return _boneIndex.findItem(_bones, boneName);
+}
+
+BoneData *SkeletonData::findBone(const NameHash &boneName) {
+	return _boneIndex.findItem(_bones, boneName);
 }
 
 SlotData *SkeletonData::findSlot(const String &slotName) {
-	return ContainerUtil::findWithName(_slots, slotName);
+	return _slotIndex.findItem(_slots, slotName);
+}
+
+SlotData *SkeletonData::findSlot(const NameHash &slotName) {
+	return _slotIndex.findItem(_slots, slotName);
 }
 
 Skin *SkeletonData::findSkin(const String &skinName) {
-	return ContainerUtil::findWithName(_skins, skinName);
+	return _skinIndex.findItem(_skins, skinName);
+}
+
+Skin *SkeletonData::findSkin(const NameHash &skinName) {
+	return _skinIndex.findItem(_skins, skinName);
 }
 
 spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
-	return ContainerUtil::findWithName(_events, eventDataName);
+	return _eventIndex.findItem(_events, eventDataName);
+}
+
+spine::EventData *SkeletonData::findEvent(const NameHash &eventDataName) {
+	return _eventIndex.findItem(_events, eventDataName);
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	Animation *animation = _animationIndex.findItem(_animations, animationName);
+	if (animation && _animationDecoder && !_animationDecoder->load(animation)) return NULL;
+	return animation;
+}
+
+Animation *SkeletonData::findAnimation(const NameHash &animationName) {
+	Animation *animation = _animationIndex.findItem(_animations, animationName);
+	if (animation && _animationDecoder && !_animationDecoder->load(animation)) return NULL;
+	return animation;
+}
+
+bool SkeletonData::loadAnimation(Animation *animation) {
+	return !_animationDecoder || _animationDecoder->load(animation);
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_ikConstraints, constraintName);
+	return _ikConstraintIndex.findItem(_ikConstraints, constraintName);
+}
+
+IkConstraintData *SkeletonData::findIkConstraint(const NameHash &constraintName) {
+	return _ikConstraintIndex.findItem(_ikConstraints, constraintName);
 }
 
 TransformConstraintData *SkeletonData::findTransformConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_transformConstraints, constraintName);
+	return _transformConstraintIndex.findItem(_transformConstraints, constraintName);
+}
+
+TransformConstraintData *SkeletonData::findTransformConstraint(const NameHash &constraintName) {
+	return _transformConstraintIndex.findItem(_transformConstraints, constraintName);
 }
 
 PathConstraintData *SkeletonData::findPathConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_pathConstraints, constraintName);
+	return _pathConstraintIndex.findItem(_pathConstraints, constraintName);
+}
+
+PathConstraintData *SkeletonData::findPathConstraint(const NameHash &constraintName) {
+	return _pathConstraintIndex.findItem(_pathConstraints, constraintName);
 }
 
 PhysicsConstraintData *SkeletonData::findPhysicsConstraint(const String &constraintName) {
-	return ContainerUtil::findWithName(_physicsConstraints, constraintName);
+	return _physicsConstraintIndex.findItem(_physicsConstraints, constraintName);
+}
+
+PhysicsConstraintData *SkeletonData::findPhysicsConstraint(const NameHash &constraintName) {
+	return _physicsConstraintIndex.findItem(_physicsConstraints, constraintName);
+}
+
+void SkeletonData::updateIndices() {
+	_boneIndex.update(_bones);
+	_slotIndex.update(_slots);
+	_skinIndex.update(_skins);
+	_eventIndex.update(_events);
+	_animationIndex.update(_animations);
+	_ikConstraintIndex.update(_ikConstraints);
+	_transformConstraintIndex.update(_transformConstraints);
+	_pathConstraintIndex.update(_pathConstraints);
+	_physicsConstraintIndex.update(_physicsConstraints);
 }
 
 const String &SkeletonData::getName() {
@@ -146,6 +205,20 @@ Vector<Animation *> &SkeletonData::getAnimations() {
 	return _animations;
 }
 
+DataArena &SkeletonData::getArena() {
+	return _arena;
+}
+
+AnimationDecoder *SkeletonData::getAnimationDecoder() {
+	return _animationDecoder;
+}
+
+void SkeletonData::setAnimationDecoder(AnimationDecoder *animationDecoder) {
+	delete _animationDecoder;
+	_animationDecoder = animationDecoder;
+	if (animationDecoder) animationDecoder->setSkeletonData(this);
+}
+
 Vector<IkConstraintData *> &SkeletonData::getIkConstraints() {
 	return _ikConstraints;
 }
@@ -32,6 +32,8 @@
 
 #include <spine/Vector.h>
 #include <spine/SpineString.h>
+#include <spine/NameIndex.h>
+#include <spine/DataArena.h>
 
 namespace spine {
 	class BoneData;
@@ -52,6 +54,8 @@ namespace spine {
 
     class PhysicsConstraintData;
 
+	class AnimationDecoder;
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 	class SP_API SkeletonData : public SpineObject {
 		friend class SkeletonBinary;
@@ -60,28 +64,49 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class AnimationDecoder;
+
 	public:
 		SkeletonData();
 
 		~SkeletonData();
 
-		/// Finds a bone by comparing each bone's name.
-		/// It is more efficient to cache the results of this method than to call it multiple times.
+		/// Finds a bone by name using a hash index, see updateIndices().
 		/// @return May be NULL.
 		BoneData *findBone(const String &boneName);
 
+		/// @return May be NULL.
+		BoneData *findBone(const NameHash &boneName);
+
 		/// @return May be NULL.
 		SlotData *findSlot(const String &slotName);
 
+		/// @return May be NULL.
+		SlotData *findSlot(const NameHash &slotName);
+
 		/// @return May be NULL.
 		Skin *findSkin(const String &skinName);
 
+		/// @return May be NULL.
+		Skin *findSkin(const NameHash &skinName);
+
 		/// @return May be NULL.
 		spine::EventData *findEvent(const String &eventDataName);
 
 		/// @return May be NULL.
+		spine::EventData *findEvent(const NameHash &eventDataName);
+
+		/// Finds an animation by name. If the skeleton data was loaded lazily, the animation is decoded if needed.
+		/// @return May be NULL, also if decoding the animation failed.
 		Animation *findAnimation(const String &animationName);
 
+		/// @return May be NULL, also if decoding the animation failed.
+		Animation *findAnimation(const NameHash &animationName);
+
+		/// Decodes the animation if the skeleton data was loaded lazily and the animation isn't loaded.
+		/// @return False if decoding failed, see AnimationDecoder::getError().
+		bool loadAnimation(Animation *animation);
+
 		/// @return May be NULL.
 		IkConstraintData *findIkConstraint(const String &constraintName);
 
@@ -94,6 +119,23 @@ namespace spine {
         /// @return May be NULL.
         PhysicsConstraintData *findPhysicsConstraint(const String &constraintName);
 
+		/// @return May be NULL.
+		IkConstraintData *findIkConstraint(const NameHash &constraintName);
+
+		/// @return May be NULL.
+		TransformConstraintData *findTransformConstraint(const NameHash &constraintName);
+
+		/// @return May be NULL.
+		PathConstraintData *findPathConstraint(const NameHash &constraintName);
+
+		/// @return May be NULL.
+		PhysicsConstraintData *findPhysicsConstraint(const NameHash &constraintName);
+
+		/// Adds items appended to the bones, slots, skins, events, animations and constraints to the hash indices used
+		/// by the find methods. The loaders call this, so it is only needed after adding items to the skeleton data
+		/// yourself. Until then the find methods fall back to comparing each item's name.
+		void updateIndices();
+
 		const String &getName();
 
 		void setName(const String &inValue);
@@ -115,8 +157,20 @@ namespace spine {
 
 		Vector<spine::EventData *> &getEvents();
 
+		/// All animations. If the skeleton data was loaded lazily, animations may not be loaded yet, see
+		/// Animation::isLoaded().
 		Vector<Animation *> &getAnimations();
 
+		/// Decodes animations on demand, or NULL if all animations were decoded when the skeleton data was loaded.
+		/// See SkeletonJson::setLazyAnimations() and SkeletonBinary::setLazyAnimations().
+		AnimationDecoder *getAnimationDecoder();
+
+		/// The memory of the bones, slots, skins, attachments, animations and all other objects the loader created, if
+		/// SkeletonJson::setUseArena() or SkeletonBinary::setUseArena() was enabled. The objects are destroyed as usual
+		/// when the skeleton data is, which frees memory they moved to the heap after loading, then the arena's chunks
+		/// are released at once.
+		DataArena &getArena();
+
 		Vector<IkConstraintData *> &getIkConstraints();
 
 		Vector<TransformConstraintData *> &getTransformConstraints();
@@ -168,6 +222,8 @@ namespace spine {
 		void setFps(float inValue);
 
 	private:
+		/* Declared first, so the other members are destroyed while the arena's memory is still valid. */
+		DataArena _arena;
 		String _name;
 		Vector<BoneData *> _bones; // Ordered parents first
 		Vector<SlotData *> _slots; // Setup pose draw order.
@@ -175,6 +231,7 @@ namespace spine {
 		Skin *_defaultSkin;
 		Vector<EventData *> _events;
 		Vector<Animation *> _animations;
+		AnimationDecoder *_animationDecoder;
 		Vector<IkConstraintData *> _ikConstraints;
 		Vector<TransformConstraintData *> _transformConstraints;
 		Vector<PathConstraintData *> _pathConstraints;
@@ -184,11 +241,22 @@ namespace spine {
 		String _version;
 		String _hash;
 		Vector<char *> _strings;
+		NameIndex _boneIndex;
+		NameIndex _slotIndex;
+		NameIndex _skinIndex;
+		NameIndex _eventIndex;
+		NameIndex _animationIndex;
+		NameIndex _ikConstraintIndex;
+		NameIndex _transformConstraintIndex;
+		NameIndex _pathConstraintIndex;
+		NameIndex _physicsConstraintIndex;
 
 		// Nonessential.
 		float _fps;
 		String _imagesPath;
 		String _audioPath;
+
+		void setAnimationDecoder(AnimationDecoder *animationDecoder);
 	};
 }
 
@@ -30,6 +30,7 @@
 #include <spine/SkeletonJson.h>
 
 #include <spine/Atlas.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/CurveTimeline.h>
 #include <spine/Json.h>
@@ -67,6 +68,7 @@
 #include <spine/ShearTimeline.h>
 #include <spine/Skin.h>
 #include <spine/SlotData.h>
+#include <spine/TaskScheduler.h>
 #include <spine/TransformConstraintData.h>
 #include <spine/TransformConstraintTimeline.h>
 #include <spine/TranslateTimeline.h>
@@ -102,701 +104,1128 @@ static void toColor(Color &color, const char *value, bool hasAlpha) {
 }
 
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new (__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-										   _scale(1), _ownsLoader(true) {}
+										   _scale(1), _ownsLoader(true), _taskScheduler(NULL),
+										   _ownsTaskScheduler(false), _lazyAnimations(false),
+										   _streaming(false), _useArena(false) {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(attachmentLoader),
 																				  _scale(1),
-																				  _ownsLoader(ownsLoader) {
+																				  _ownsLoader(ownsLoader),
+																				  _taskScheduler(NULL),
+																				  _ownsTaskScheduler(false),
+																				  _lazyAnimations(false),
+																				  _streaming(false),
+																				  _useArena(false) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonJson::SkeletonJson(float scale) : _attachmentLoader(NULL), _scale(scale), _ownsLoader(false),
+										  _taskScheduler(NULL), _ownsTaskScheduler(false), _lazyAnimations(false),
+										  _streaming(false), _useArena(false) {
+}
+
 SkeletonJson::~SkeletonJson() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 
 	if (_ownsLoader) delete _attachmentLoader;
+	if (_ownsTaskScheduler) delete _taskScheduler;
+}
+
+void SkeletonJson::setTaskScheduler(TaskScheduler *taskScheduler) {
+	if (_ownsTaskScheduler) delete _taskScheduler;
+	_taskScheduler = taskScheduler;
+	_ownsTaskScheduler = false;
+}
+
+void SkeletonJson::setThreadCount(int threadCount) {
+	setTaskScheduler(threadCount > 1 ? new (__FILE__, __LINE__) ThreadTaskScheduler(threadCount) : NULL);
+	_ownsTaskScheduler = _taskScheduler != NULL;
+}
+
+namespace {
+	struct ReadAnimationsTask {
+		SkeletonJson *loader;
+		SkeletonData *skeletonData;
+		DataArena *arena;
+		int offset;
+		Vector<Json *> maps;
+		Vector<String> errors;
+	};
+
+	/* The streaming reader only scans the structure of the text to find where values begin and end, then parses
+	 * one value at a time into its own small Json document. */
+	struct JsonRange {
+		const char *start;
+		const char *end;
+
+		JsonRange() : start(NULL), end(NULL) {}
+	};
+
+	const char *skipWhitespace(const char *value, const char *end) {
+		while (value < end && (unsigned char) *value <= 32) value++;
+		return value;
+	}
+
+	/* Returns the character after the closing quote, or NULL if the string is not terminated. */
+	const char *skipString(const char *value, const char *end) {
+		for (value++; value < end; value++) {
+			if (*value == '\\') value++;
+			else if (*value == '"')
+				return value + 1;
+		}
+		return NULL;
+	}
+
+	/* Returns the character after the value, or NULL if an object, array or string is not terminated. */
+	const char *skipValue(const char *value, const char *end) {
+		if (value >= end) return NULL;
+		if (*value == '"') return skipString(value, end);
+		if (*value != '{' && *value != '[') {
+			while (value < end && *value != ',' && *value != '}' && *value != ']' && (unsigned char) *value > 32)
+				value++;
+			return value;
+		}
+		int depth = 0;
+		while (value < end) {
+			switch (*value) {
+				case '"':
+					value = skipString(value, end);
+					if (!value) return NULL;
+					continue;
+				case '{':
+				case '[':
+					depth++;
+					break;
+				case '}':
+				case ']':
+					if (--depth == 0) return value + 1;
+					break;
+			}
+			value++;
+		}
+		return NULL;
+	}
+
+	/* Iterates the elements of an array or the members of an object. For members, start is the key's opening quote
+	 * and value the start of its value. */
+	class JsonElements {
+	public:
+		JsonElements(const char *value, const char *end) : _value(value + 1), _end(end), _object(*value == '{'),
+														  _error(false) {
+		}
+
+		bool next(const char *&start, const char *&value, const char *&last) {
+			_value = skipWhitespace(_value, _end);
+			if (_value >= _end) return fail();
+			if (*_value == ']' || *_value == '}') return false;
+			start = _value;
+			if (_object) {
+				if (*_value != '"' || !(_value = skipString(_value, _end))) return fail();
+				_value = skipWhitespace(_value, _end);
+				if (_value >= _end || *_value != ':') return fail();
+				_value = skipWhitespace(_value + 1, _end);
+			}
+			value = _value;
+			if (!(_value = skipValue(_value, _end)) || _value == value) return fail();
+			last = _value;
+			_value = skipWhitespace(_value, _end);
+			if (_value < _end && *_value == ',') _value++;
+			return true;
+		}
+
+		bool isObject() { return _object; }
+
+		bool hasError() { return _error; }
+
+	private:
+		const char *_value;
+		const char *_end;
+		bool _object;
+		bool _error;
+
+		bool fail() {
+			_error = true;
+			return false;
+		}
+	};
+
+	/* Parses the text from start to end, wrapped in open and close, into a new document. */
+	Json *parseRange(const char *start, const char *end, const char *open, const char *close, Vector<char> &buffer) {
+		/* The document is freed once read, so it is never put in the skeleton data's arena. */
+		DataArena::Scope heap(NULL);
+		size_t openLength = strlen(open), length = end - start, closeLength = strlen(close);
+		buffer.setSize(openLength + length + closeLength + 1, 0);
+		char *text = buffer.buffer();
+		memcpy(text, open, openLength);
+		memcpy(text + openLength, start, length);
+		memcpy(text + openLength + length, close, closeLength + 1);
+		return new (__FILE__, __LINE__) Json(text);
+	}
+}
+
+namespace spine {
+	/// Decodes animations from a copy of the animations text, parsing only the animation being decoded.
+	class JsonAnimationDecoder : public AnimationDecoder {
+	public:
+		JsonAnimationDecoder(float scale, const char *text, size_t length, Vector<size_t> &offsets) : _json(scale),
+																									 _offsets(offsets) {
+			_text.setSize(length, 0);
+			memcpy(_text.buffer(), text, length);
+		}
+
+		virtual ~JsonAnimationDecoder() {
+			waitForPrefetch();
+		}
+
+	protected:
+		virtual Animation *decode(SkeletonData *skeletonData, int index, String &error) override {
+			Vector<char> buffer;
+			const char *text = _text.buffer();
+			Json *root = parseRange(text + _offsets[index * 2], text + _offsets[index * 2 + 1], "{", "}", buffer);
+			Animation *animation = _json.readAnimation(root->_child, skeletonData, error);
+			delete root;
+			return animation;
+		}
+
+	private:
+		SkeletonJson _json;
+		Vector<char> _text;
+		Vector<size_t> _offsets;
+	};
+}
+
+void SkeletonJson::readAnimationTask(int index, void *userData) {
+	ReadAnimationsTask *task = (ReadAnimationsTask *) userData;
+	DataArena::Scope arena(task->arena);
+	task->skeletonData->_animations[task->offset + index] = task->loader->readAnimation(task->maps[index],
+																						   task->skeletonData,
+																						   task->errors[index]);
 }
 
 SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
-	int length;
+	MappedFile file;
 	SkeletonData *skeletonData;
-	const char *json = SpineExtension::readFile(path, &length);
-	if (length == 0 || !json) {
+	if (!SpineExtension::mapFile(path, file) || file.length == 0) {
+		SpineExtension::unmapFile(file);
 		setError(NULL, "Unable to read skeleton file: ", path);
 		return NULL;
 	}
 
-	skeletonData = readSkeletonData(json);
+	skeletonData = readSkeletonData(file.data);
 
-	SpineExtension::free(json, __FILE__, __LINE__);
+	SpineExtension::unmapFile(file);
 
 	return skeletonData;
 }
 
-SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
-	int i, ii;
-	SkeletonData *skeletonData;
-	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *physics, *slots, *skins, *animations, *events;
+const char *const SkeletonJson::_sectionNames[Section_Count] = {"bones", "slots", "ik", "transform", "path", "physics",
+																  "skins", "events"};
+
+bool SkeletonJson::readItem(int section, Json *map, SkeletonData *skeletonData) {
+	switch (section) {
+		case Section_Bones:
+			return readBone(map, skeletonData);
+		case Section_Slots:
+			return readSlot(map, skeletonData);
+		case Section_Ik:
+			return readIkConstraint(map, skeletonData);
+		case Section_Transform:
+			return readTransformConstraint(map, skeletonData);
+		case Section_Path:
+			return readPathConstraint(map, skeletonData);
+		case Section_Physics:
+			return readPhysicsConstraint(map, skeletonData);
+		case Section_Skins:
+			return readSkin(map, skeletonData);
+		case Section_Events:
+			return readEvent(map, skeletonData);
+		default:
+			return false;
+	}
+}
+
+String SkeletonJson::readKey(const char *start, const char *end, Vector<char> &buffer) {
+	DataArena::Scope heap(NULL);
+	const char *keyEnd = skipString(start, end);
+	if (!keyEnd) return String();
+	buffer.setSize(keyEnd - start, 0);
+	size_t length;
+	Json::unescapeString(start, buffer.buffer(), length);
+	return String(buffer.buffer());
+}
 
+SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 	_error = "";
-	_linkedMeshes.clear();
+	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+
+	SkeletonData *skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	if (_streaming ? readSkeletonDataStreaming(json, skeletonData) : readSkeletonData(json, skeletonData))
+		return skeletonData;
+	delete skeletonData;
+	return NULL;
+}
+
+bool SkeletonJson::readSkeletonData(const char *json, SkeletonData *skeletonData) {
+	Json *root, *skeleton, *animations, *animationMap;
 
 	root = new (__FILE__, __LINE__) Json(json);
 
 	if (!root) {
 		setError(NULL, "Invalid skeleton JSON: ", Json::getError());
-		return NULL;
+		return false;
 	}
 
-	skeletonData = new (__FILE__, __LINE__) SkeletonData();
+	DataArena::Scope arena(_useArena ? &skeletonData->getArena() : NULL);
 
 	skeleton = Json::getItem(root, "skeleton");
-	if (skeleton) {
-		skeletonData->_hash = Json::getString(skeleton, "hash", 0);
-		skeletonData->_version = Json::getString(skeleton, "spine", 0);
-		if (!skeletonData->_version.startsWith(SPINE_VERSION_STRING)) {
-			char errorMsg[255];
-			snprintf(errorMsg, 255, "Skeleton version %s does not match runtime version %s", skeletonData->_version.buffer(), SPINE_VERSION_STRING);
-			delete skeletonData;
-			setError(NULL, errorMsg, "");
-			return NULL;
-		}
-		skeletonData->_x = Json::getFloat(skeleton, "x", 0);
-		skeletonData->_y = Json::getFloat(skeleton, "y", 0);
-		skeletonData->_width = Json::getFloat(skeleton, "width", 0);
-		skeletonData->_height = Json::getFloat(skeleton, "height", 0);
-		skeletonData->_referenceScale = Json::getFloat(skeleton, "referenceScale", 100) * _scale;
-		skeletonData->_fps = Json::getFloat(skeleton, "fps", 30);
-		skeletonData->_audioPath = Json::getString(skeleton, "audio", 0);
-		skeletonData->_imagesPath = Json::getString(skeleton, "images", 0);
+	if (skeleton && !readSkeleton(skeleton, skeletonData)) {
+		delete root;
+		return false;
 	}
 
-	/* Bones. */
-	bones = Json::getItem(root, "bones");
-	skeletonData->_bones.setSize(bones->_size, 0);
-	int bonesCount = 0;
-	for (boneMap = bones->_child, i = 0; boneMap; boneMap = boneMap->_next, ++i) {
-		BoneData *data;
-		const char *inherit;
-
-		BoneData *parent = 0;
-		const char *parentName = Json::getString(boneMap, "parent", 0);
-		if (parentName) {
-			parent = skeletonData->findBone(parentName);
-			if (!parent) {
-				delete skeletonData;
-				setError(root, "Parent bone not found: ", parentName);
-				return NULL;
+	for (int section = 0; section < Section_Count; section++) {
+		Json *items = Json::getItem(root, _sectionNames[section]);
+		if (!items) continue;
+		for (Json *map = items->_child; map; map = map->_next) {
+			if (!readItem(section, map, skeletonData)) {
+				delete root;
+				return false;
 			}
+			skeletonData->updateIndices();
 		}
+	}
 
-		data = new (__FILE__, __LINE__) BoneData(bonesCount, Json::getString(boneMap, "name", 0), parent);
-
-		data->_length = Json::getFloat(boneMap, "length", 0) * _scale;
-		data->_x = Json::getFloat(boneMap, "x", 0) * _scale;
-		data->_y = Json::getFloat(boneMap, "y", 0) * _scale;
-		data->_rotation = Json::getFloat(boneMap, "rotation", 0);
-		data->_scaleX = Json::getFloat(boneMap, "scaleX", 1);
-		data->_scaleY = Json::getFloat(boneMap, "scaleY", 1);
-		data->_shearX = Json::getFloat(boneMap, "shearX", 0);
-		data->_shearY = Json::getFloat(boneMap, "shearY", 0);
-		inherit = Json::getString(boneMap, "inherit", "normal");
-		data->_inherit = Inherit_Normal;
-		if (strcmp(inherit, "normal") == 0) data->_inherit = Inherit_Normal;
-		else if (strcmp(inherit, "onlyTranslation") == 0)
-			data->_inherit = Inherit_OnlyTranslation;
-		else if (strcmp(inherit, "noRotationOrReflection") == 0)
-			data->_inherit = Inherit_NoRotationOrReflection;
-		else if (strcmp(inherit, "noScale") == 0)
-			data->_inherit = Inherit_NoScale;
-		else if (strcmp(inherit, "noScaleOrReflection") == 0)
-			data->_inherit = Inherit_NoScaleOrReflection;
-		data->_skinRequired = Json::getBoolean(boneMap, "skin", false);
-
-		const char *color = Json::getString(boneMap, "color", NULL);
-		if (color) toColor(data->getColor(), color, true);
-
-		data->_icon = Json::getString(boneMap, "icon", "");
-		data->_visible = Json::getBoolean(boneMap, "visible", true);
-
-		skeletonData->_bones[i] = data;
-		bonesCount++;
+	if (!linkMeshes(skeletonData)) {
+		delete root;
+		return false;
 	}
 
-	/* Slots. */
-	slots = Json::getItem(root, "slots");
-	if (slots) {
-		Json *slotMap;
-		skeletonData->_slots.ensureCapacity(slots->_size);
-		skeletonData->_slots.setSize(slots->_size, 0);
-		for (slotMap = slots->_child, i = 0; slotMap; slotMap = slotMap->_next, ++i) {
-			SlotData *data;
-			const char *color;
-			const char *dark;
-			Json *item;
-
-			const char *boneName = Json::getString(slotMap, "bone", 0);
-			BoneData *boneData = skeletonData->findBone(boneName);
-			if (!boneData) {
-				delete skeletonData;
-				setError(root, "Slot bone not found: ", boneName);
-				return NULL;
+	/* Animations. */
+	animations = Json::getItem(root, "animations");
+	if (animations && _lazyAnimations) {
+		/* Find the animations text again, so the document doesn't have to be kept for the decoder. */
+		const char *end = json + strlen(json), *start, *value, *last;
+		Vector<char> buffer;
+		JsonElements members(skipWhitespace(json, end), end);
+		bool found = false;
+		while (!found && members.next(start, value, last))
+			found = Json::json_strcasecmp(readKey(start, end, buffer).buffer(), "animations") == 0;
+		if (!found || !readLazyAnimations(value, last, skeletonData)) {
+			setError(root, "Invalid skeleton JSON: ", "animations");
+			return false;
+		}
+	} else if (animations) {
+		skeletonData->_animations.ensureCapacity(animations->_size);
+		skeletonData->_animations.setSize(animations->_size, 0);
+		if (_taskScheduler && animations->_size > 1) {
+			/* Each animation only reads the skeleton data, so they can be decoded concurrently. Errors are kept per
+			 * animation and the first one in file order is reported, so failures don't depend on scheduling. */
+			ReadAnimationsTask task;
+			task.loader = this;
+			task.skeletonData = skeletonData;
+			task.arena = DataArena::getCurrent();
+			task.offset = 0;
+			task.maps.ensureCapacity(animations->_size);
+			for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next)
+				task.maps.add(animationMap);
+			task.errors.setSize(animations->_size, String());
+			_taskScheduler->parallelFor(animations->_size, readAnimationTask, &task);
+			for (int i = 0; i < animations->_size; i++) {
+				if (!skeletonData->_animations[i]) {
+					setError(_error, task.errors[i], "");
+					delete root;
+					return false;
+				}
+			}
+		} else {
+			int animationsIndex = 0;
+			for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next) {
+				Animation *animation = readAnimation(animationMap, skeletonData, _error);
+				if (!animation) {
+					delete root;
+					return false;
+				}
+				skeletonData->_animations[animationsIndex++] = animation;
 			}
+		}
+	}
 
-			String slotName = String(Json::getString(slotMap, "name", 0));
-			data = new (__FILE__, __LINE__) SlotData(i, slotName, *boneData);
+	delete root;
 
-			color = Json::getString(slotMap, "color", 0);
-			if (color) {
-				Color &c = data->getColor();
-				c.r = toColor(color, 0);
-				c.g = toColor(color, 1);
-				c.b = toColor(color, 2);
-				c.a = toColor(color, 3);
-			}
+	skeletonData->updateIndices();
+	return true;
+}
 
-			dark = Json::getString(slotMap, "dark", 0);
-			if (dark) {
-				Color &darkColor = data->getDarkColor();
-				darkColor.r = toColor(dark, 0);
-				darkColor.g = toColor(dark, 1);
-				darkColor.b = toColor(dark, 2);
-				darkColor.a = 1;
-				data->setHasDarkColor(true);
+bool SkeletonJson::readSkeletonDataStreaming(const char *json, SkeletonData *skeletonData) {
+	const char *end = json + strlen(json);
+	const char *start, *value, *last;
+	Vector<char> buffer;
+
+	/* Locate each top level value without parsing it: the skeleton, the item sections, then the animations. The
+	 * first occurrence of a key wins, as with Json::getItem(). */
+	JsonRange skeletonRange, sectionRanges[Section_Count], animationsRange;
+	value = skipWhitespace(json, end);
+	if (value == end || *value != '{') {
+		setError(_error, "Invalid skeleton JSON: ", "expected an object");
+		return false;
+	}
+	JsonElements members(value, end);
+	while (members.next(start, value, last)) {
+		String key = readKey(start, end, buffer);
+		JsonRange *range = NULL;
+		if (Json::json_strcasecmp(key.buffer(), "skeleton") == 0)
+			range = &skeletonRange;
+		else if (Json::json_strcasecmp(key.buffer(), "animations") == 0)
+			range = &animationsRange;
+		else {
+			for (int section = 0; section < Section_Count; section++) {
+				if (Json::json_strcasecmp(key.buffer(), _sectionNames[section]) == 0) {
+					range = &sectionRanges[section];
+					break;
+				}
 			}
+		}
+		if (range && !range->start) {
+			range->start = value;
+			range->end = last;
+		}
+	}
+	if (members.hasError()) {
+		setError(_error, "Invalid skeleton JSON: ", "malformed top level object");
+		return false;
+	}
 
-			item = Json::getItem(slotMap, "attachment");
-			if (item) data->setAttachmentName(item->_valueString);
+	DataArena::Scope arena(_useArena ? &skeletonData->getArena() : NULL);
 
-			item = Json::getItem(slotMap, "blend");
-			if (item) {
-				if (strcmp(item->_valueString, "additive") == 0) data->_blendMode = BlendMode_Additive;
-				else if (strcmp(item->_valueString, "multiply") == 0)
-					data->_blendMode = BlendMode_Multiply;
-				else if (strcmp(item->_valueString, "screen") == 0)
-					data->_blendMode = BlendMode_Screen;
-			}
-			data->_visible = Json::getBoolean(slotMap, "visible", true);
-			skeletonData->_slots[i] = data;
+	if (skeletonRange.start) {
+		Json *skeleton = parseRange(skeletonRange.start, skeletonRange.end, "", "", buffer);
+		bool read = readSkeleton(skeleton, skeletonData);
+		delete skeleton;
+		if (!read) return false;
+	}
+
+	/* Only one item is parsed at a time and freed once it has been read. */
+	for (int section = 0; section < Section_Count; section++) {
+		JsonRange &range = sectionRanges[section];
+		if (!range.start || (*range.start != '[' && *range.start != '{')) continue;
+		JsonElements items(range.start, range.end);
+		while (items.next(start, value, last)) {
+			bool member = items.isObject();
+			Json *root = parseRange(start, last, member ? "{" : "", member ? "}" : "", buffer);
+			bool read = readItem(section, member ? root->_child : root, skeletonData);
+			delete root;
+			if (!read) return false;
+			skeletonData->updateIndices();
+		}
+		if (items.hasError()) {
+			setError(_error, "Invalid skeleton JSON: ", _sectionNames[section]);
+			return false;
 		}
 	}
 
-	/* IK constraints. */
-	ik = Json::getItem(root, "ik");
-	if (ik) {
-		Json *constraintMap;
-		skeletonData->_ikConstraints.ensureCapacity(ik->_size);
-		skeletonData->_ikConstraints.setSize(ik->_size, 0);
-		for (constraintMap = ik->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *targetName;
-
-			IkConstraintData *data = new (__FILE__, __LINE__) IkConstraintData(
-					Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "IK bone not found: ", boneMap->_valueString);
-					return NULL;
+	/* Linked meshes may name skins that come later, so they are resolved once all skins are read. */
+	if (!linkMeshes(skeletonData)) return false;
+
+	/* Animations. */
+	JsonRange &animations = animationsRange;
+	if (animations.start && *animations.start == '{') {
+		if (_lazyAnimations) {
+			if (!readLazyAnimations(animations.start, animations.end, skeletonData)) {
+				setError(_error, "Invalid skeleton JSON: ", "animations");
+				return false;
+			}
+		} else {
+			/* Animations are parsed and decoded in small batches, in parallel when there is a task scheduler. */
+			JsonElements items(animations.start, animations.end);
+			ReadAnimationsTask task;
+			task.loader = this;
+			task.skeletonData = skeletonData;
+			task.arena = DataArena::getCurrent();
+			Vector<Json *> roots;
+			size_t batchSize = _taskScheduler ? 16 : 1;
+			bool more = true;
+			while (more) {
+				roots.clear();
+				task.maps.clear();
+				while (task.maps.size() < batchSize && (more = items.next(start, value, last))) {
+					Json *root = parseRange(start, last, "{", "}", buffer);
+					roots.add(root);
+					task.maps.add(root->_child);
+				}
+				int count = (int) task.maps.size();
+				if (count == 0) break;
+				task.offset = (int) skeletonData->_animations.size();
+				skeletonData->_animations.setSize(task.offset + count, 0);
+				task.errors.clear();
+				task.errors.setSize(count, String());
+				if (_taskScheduler && count > 1)
+					_taskScheduler->parallelFor(count, readAnimationTask, &task);
+				else
+					for (int i = 0; i < count; i++) readAnimationTask(i, &task);
+				ContainerUtil::cleanUpVectorOfPointers(roots);
+				for (int i = 0; i < count; i++) {
+					if (!skeletonData->_animations[task.offset + i]) {
+						setError(_error, task.errors[i], "");
+						return false;
+					}
 				}
 			}
-
-			targetName = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findBone(targetName);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target bone not found: ", targetName);
-				return NULL;
+			if (items.hasError()) {
+				setError(_error, "Invalid skeleton JSON: ", "animations");
+				return false;
 			}
+		}
+	}
 
-			data->_mix = Json::getFloat(constraintMap, "mix", 1);
-			data->_softness = Json::getFloat(constraintMap, "softness", 0) * _scale;
-			data->_bendDirection = Json::getInt(constraintMap, "bendPositive", 1) ? 1 : -1;
-			data->_compress = Json::getInt(constraintMap, "compress", 0) ? true : false;
-			data->_stretch = Json::getInt(constraintMap, "stretch", 0) ? true : false;
-			data->_uniform = Json::getInt(constraintMap, "uniform", 0) ? true : false;
+	skeletonData->updateIndices();
+	return true;
+}
+
+bool SkeletonJson::readLazyAnimations(const char *animations, const char *end, SkeletonData *skeletonData) {
+	/* Create empty animations and keep only the animations text. Each animation is parsed from its own range when it
+	 * is first used. */
+	const char *start, *value, *last;
+	Vector<char> buffer;
+	Vector<size_t> offsets;
+	if (*animations != '{') return false;
+	JsonElements items(animations, end);
+	while (items.next(start, value, last)) {
+		String name = readKey(start, end, buffer);
+		if (name.isEmpty()) return false;
+		Vector<Timeline *> timelines;
+		skeletonData->_animations.add(new (__FILE__, __LINE__) Animation(name, timelines, 0));
+		offsets.add(start - animations);
+		offsets.add(last - animations);
+	}
+	if (items.hasError()) return false;
+	skeletonData->setAnimationDecoder(
+			new (__FILE__, __LINE__) JsonAnimationDecoder(_scale, animations, end - animations, offsets));
+	return true;
+}
+
+bool SkeletonJson::readSkeleton(Json *skeleton, SkeletonData *skeletonData) {
+	skeletonData->_hash = Json::getString(skeleton, "hash", 0);
+	skeletonData->_version = Json::getString(skeleton, "spine", 0);
+	if (!skeletonData->_version.startsWith(SPINE_VERSION_STRING)) {
+		char errorMsg[255];
+		snprintf(errorMsg, 255, "Skeleton version %s does not match runtime version %s", skeletonData->_version.buffer(), SPINE_VERSION_STRING);
+		setError(_error, errorMsg, "");
+		return false;
+	}
+	skeletonData->_x = Json::getFloat(skeleton, "x", 0);
+	skeletonData->_y = Json::getFloat(skeleton, "y", 0);
+	skeletonData->_width = Json::getFloat(skeleton, "width", 0);
+	skeletonData->_height = Json::getFloat(skeleton, "height", 0);
+	skeletonData->_referenceScale = Json::getFloat(skeleton, "referenceScale", 100) * _scale;
+	skeletonData->_fps = Json::getFloat(skeleton, "fps", 30);
+	skeletonData->_audioPath = Json::getString(skeleton, "audio", 0);
+	skeletonData->_imagesPath = Json::getString(skeleton, "images", 0);
+	return true;
+}
 
-			skeletonData->_ikConstraints[i] = data;
+bool SkeletonJson::readBone(Json *boneMap, SkeletonData *skeletonData) {
+	BoneData *data;
+	const char *inherit;
+
+	BoneData *parent = 0;
+	const char *parentName = Json::getString(boneMap, "parent", 0);
+	if (parentName) {
+		parent = skeletonData->findBone(parentName);
+		if (!parent) {
+			setError(_error, "Parent bone not found: ", parentName);
+			return false;
 		}
 	}
 
-	/* Transform constraints. */
-	transform = Json::getItem(root, "transform");
-	if (transform) {
-		Json *constraintMap;
-		skeletonData->_transformConstraints.ensureCapacity(transform->_size);
-		skeletonData->_transformConstraints.setSize(transform->_size, 0);
-		for (constraintMap = transform->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *name;
-
-			TransformConstraintData *data = new (__FILE__, __LINE__) TransformConstraintData(
-					Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "Transform bone not found: ", boneMap->_valueString);
-					return NULL;
-				}
-			}
+	data = new (__FILE__, __LINE__) BoneData((int) skeletonData->_bones.size(), Json::getString(boneMap, "name", 0), parent);
+
+	data->_length = Json::getFloat(boneMap, "length", 0) * _scale;
+	data->_x = Json::getFloat(boneMap, "x", 0) * _scale;
+	data->_y = Json::getFloat(boneMap, "y", 0) * _scale;
+	data->_rotation = Json::getFloat(boneMap, "rotation", 0);
+	data->_scaleX = Json::getFloat(boneMap, "scaleX", 1);
+	data->_scaleY = Json::getFloat(boneMap, "scaleY", 1);
+	data->_shearX = Json::getFloat(boneMap, "shearX", 0);
+	data->_shearY = Json::getFloat(boneMap, "shearY", 0);
+	inherit = Json::getString(boneMap, "inherit", "normal");
+	data->_inherit = Inherit_Normal;
+	if (strcmp(inherit, "normal") == 0) data->_inherit = Inherit_Normal;
+	else if (strcmp(inherit, "onlyTranslation") == 0)
+		data->_inherit = Inherit_OnlyTranslation;
+	else if (strcmp(inherit, "noRotationOrReflection") == 0)
+		data->_inherit = Inherit_NoRotationOrReflection;
+	else if (strcmp(inherit, "noScale") == 0)
+		data->_inherit = Inherit_NoScale;
+	else if (strcmp(inherit, "noScaleOrReflection") == 0)
+		data->_inherit = Inherit_NoScaleOrReflection;
+	data->_skinRequired = Json::getBoolean(boneMap, "skin", false);
+
+	const char *color = Json::getString(boneMap, "color", NULL);
+	if (color) toColor(data->getColor(), color, true);
+
+	data->_icon = Json::getString(boneMap, "icon", "");
+	data->_visible = Json::getBoolean(boneMap, "visible", true);
+
+	skeletonData->_bones.add(data);
+	return true;
+}
 
-			name = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findBone(name);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target bone not found: ", name);
-				return NULL;
-			}
+bool SkeletonJson::readSlot(Json *slotMap, SkeletonData *skeletonData) {
+	SlotData *data;
+	const char *color;
+	const char *dark;
+	Json *item;
+
+	const char *boneName = Json::getString(slotMap, "bone", 0);
+	BoneData *boneData = skeletonData->findBone(boneName);
+	if (!boneData) {
+		setError(_error, "Slot bone not found: ", boneName);
+		return false;
+	}
+
+	String slotName = String(Json::getString(slotMap, "name", 0));
+	data = new (__FILE__, __LINE__) SlotData((int) skeletonData->_slots.size(), slotName, *boneData);
+
+	color = Json::getString(slotMap, "color", 0);
+	if (color) {
+		Color &c = data->getColor();
+		c.r = toColor(color, 0);
+		c.g = toColor(color, 1);
+		c.b = toColor(color, 2);
+		c.a = toColor(color, 3);
+	}
+
+	dark = Json::getString(slotMap, "dark", 0);
+	if (dark) {
+		Color &darkColor = data->getDarkColor();
+		darkColor.r = toColor(dark, 0);
+		darkColor.g = toColor(dark, 1);
+		darkColor.b = toColor(dark, 2);
+		darkColor.a = 1;
+		data->setHasDarkColor(true);
+	}
+
+	item = Json::getItem(slotMap, "attachment");
+	if (item) data->setAttachmentName(String::atom(item->_valueString));
+
+	item = Json::getItem(slotMap, "blend");
+	if (item) {
+		if (strcmp(item->_valueString, "additive") == 0) data->_blendMode = BlendMode_Additive;
+		else if (strcmp(item->_valueString, "multiply") == 0)
+			data->_blendMode = BlendMode_Multiply;
+		else if (strcmp(item->_valueString, "screen") == 0)
+			data->_blendMode = BlendMode_Screen;
+	}
+	data->_visible = Json::getBoolean(slotMap, "visible", true);
+	skeletonData->_slots.add(data);
+	return true;
+}
 
-			data->_local = Json::getInt(constraintMap, "local", 0) ? true : false;
-			data->_relative = Json::getInt(constraintMap, "relative", 0) ? true : false;
-			data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
-			data->_offsetX = Json::getFloat(constraintMap, "x", 0) * _scale;
-			data->_offsetY = Json::getFloat(constraintMap, "y", 0) * _scale;
-			data->_offsetScaleX = Json::getFloat(constraintMap, "scaleX", 0);
-			data->_offsetScaleY = Json::getFloat(constraintMap, "scaleY", 0);
-			data->_offsetShearY = Json::getFloat(constraintMap, "shearY", 0);
-
-			data->_mixRotate = Json::getFloat(constraintMap, "mixRotate", 1);
-			data->_mixX = Json::getFloat(constraintMap, "mixX", 1);
-			data->_mixY = Json::getFloat(constraintMap, "mixY", data->_mixX);
-			data->_mixScaleX = Json::getFloat(constraintMap, "mixScaleX", 1);
-			data->_mixScaleY = Json::getFloat(constraintMap, "mixScaleY", data->_mixScaleX);
-			data->_mixShearY = Json::getFloat(constraintMap, "mixShearY", 1);
-
-			skeletonData->_transformConstraints[i] = data;
+bool SkeletonJson::readIkConstraint(Json *constraintMap, SkeletonData *skeletonData) {
+	const char *targetName;
+	int ii;
+
+	IkConstraintData *data = new (__FILE__, __LINE__) IkConstraintData(
+			Json::getString(constraintMap, "name", 0));
+	data->setOrder(Json::getInt(constraintMap, "order", 0));
+	data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
+
+	Json *boneMap = Json::getItem(constraintMap, "bones");
+	data->_bones.ensureCapacity(boneMap->_size);
+	data->_bones.setSize(boneMap->_size, 0);
+	for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
+		data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
+		if (!data->_bones[ii]) {
+			delete data;
+			setError(_error, "IK bone not found: ", boneMap->_valueString);
+			return false;
 		}
 	}
 
-	/* Path constraints */
-	path = Json::getItem(root, "path");
-	if (path) {
-		Json *constraintMap;
-		skeletonData->_pathConstraints.ensureCapacity(path->_size);
-		skeletonData->_pathConstraints.setSize(path->_size, 0);
-		for (constraintMap = path->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *name;
-			const char *item;
-
-			PathConstraintData *data = new (__FILE__, __LINE__) PathConstraintData(
-					Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			boneMap = Json::getItem(constraintMap, "bones");
-			data->_bones.ensureCapacity(boneMap->_size);
-			data->_bones.setSize(boneMap->_size, 0);
-			for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
-				data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
-				if (!data->_bones[ii]) {
-					delete skeletonData;
-					setError(root, "Path bone not found: ", boneMap->_valueString);
-					return NULL;
-				}
-			}
+	targetName = Json::getString(constraintMap, "target", 0);
+	data->_target = skeletonData->findBone(targetName);
+	if (!data->_target) {
+		delete data;
+		setError(_error, "Target bone not found: ", targetName);
+		return false;
+	}
 
-			name = Json::getString(constraintMap, "target", 0);
-			data->_target = skeletonData->findSlot(name);
-			if (!data->_target) {
-				delete skeletonData;
-				setError(root, "Target slot not found: ", name);
-				return NULL;
-			}
+	data->_mix = Json::getFloat(constraintMap, "mix", 1);
+	data->_softness = Json::getFloat(constraintMap, "softness", 0) * _scale;
+	data->_bendDirection = Json::getInt(constraintMap, "bendPositive", 1) ? 1 : -1;
+	data->_compress = Json::getInt(constraintMap, "compress", 0) ? true : false;
+	data->_stretch = Json::getInt(constraintMap, "stretch", 0) ? true : false;
+	data->_uniform = Json::getInt(constraintMap, "uniform", 0) ? true : false;
 
-			item = Json::getString(constraintMap, "positionMode", "percent");
-			if (strcmp(item, "fixed") == 0) {
-				data->_positionMode = PositionMode_Fixed;
-			} else if (strcmp(item, "percent") == 0) {
-				data->_positionMode = PositionMode_Percent;
-			}
+	skeletonData->_ikConstraints.add(data);
+	return true;
+}
 
-			item = Json::getString(constraintMap, "spacingMode", "length");
-			if (strcmp(item, "length") == 0) data->_spacingMode = SpacingMode_Length;
-			else if (strcmp(item, "fixed") == 0)
-				data->_spacingMode = SpacingMode_Fixed;
-			else if (strcmp(item, "percent") == 0)
-				data->_spacingMode = SpacingMode_Percent;
-			else
-				data->_spacingMode = SpacingMode_Proportional;
-
-			item = Json::getString(constraintMap, "rotateMode", "tangent");
-			if (strcmp(item, "tangent") == 0) data->_rotateMode = RotateMode_Tangent;
-			else if (strcmp(item, "chain") == 0)
-				data->_rotateMode = RotateMode_Chain;
-			else if (strcmp(item, "chainScale") == 0)
-				data->_rotateMode = RotateMode_ChainScale;
-
-			data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
-			data->_position = Json::getFloat(constraintMap, "position", 0);
-			if (data->_positionMode == PositionMode_Fixed) data->_position *= _scale;
-			data->_spacing = Json::getFloat(constraintMap, "spacing", 0);
-			if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed)
-				data->_spacing *= _scale;
-			data->_mixRotate = Json::getFloat(constraintMap, "mixRotate", 1);
-			data->_mixX = Json::getFloat(constraintMap, "mixX", 1);
-			data->_mixY = Json::getFloat(constraintMap, "mixY", data->_mixX);
-
-			skeletonData->_pathConstraints[i] = data;
+bool SkeletonJson::readTransformConstraint(Json *constraintMap, SkeletonData *skeletonData) {
+	const char *name;
+	int ii;
+
+	TransformConstraintData *data = new (__FILE__, __LINE__) TransformConstraintData(
+			Json::getString(constraintMap, "name", 0));
+	data->setOrder(Json::getInt(constraintMap, "order", 0));
+	data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
+
+	Json *boneMap = Json::getItem(constraintMap, "bones");
+	data->_bones.ensureCapacity(boneMap->_size);
+	data->_bones.setSize(boneMap->_size, 0);
+	for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
+		data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
+		if (!data->_bones[ii]) {
+			delete data;
+			setError(_error, "Transform bone not found: ", boneMap->_valueString);
+			return false;
 		}
 	}
 
-	/* Physics constraints */
-	physics = Json::getItem(root, "physics");
-	if (physics) {
-		Json *constraintMap;
-		skeletonData->_physicsConstraints.ensureCapacity(physics->_size);
-		skeletonData->_physicsConstraints.setSize(physics->_size, 0);
-		for (constraintMap = physics->_child, i = 0; constraintMap; constraintMap = constraintMap->_next, ++i) {
-			const char *name;
-
-			PhysicsConstraintData *data = new (__FILE__, __LINE__) PhysicsConstraintData(
-					Json::getString(constraintMap, "name", 0));
-			data->setOrder(Json::getInt(constraintMap, "order", 0));
-			data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
-
-			name = Json::getString(constraintMap, "bone", 0);
-			data->_bone = skeletonData->findBone(name);
-			if (!data->_bone) {
-				delete skeletonData;
-				setError(root, "Physics bone not found: ", name);
-				return NULL;
-			}
+	name = Json::getString(constraintMap, "target", 0);
+	data->_target = skeletonData->findBone(name);
+	if (!data->_target) {
+		delete data;
+		setError(_error, "Target bone not found: ", name);
+		return false;
+	}
+
+	data->_local = Json::getInt(constraintMap, "local", 0) ? true : false;
+	data->_relative = Json::getInt(constraintMap, "relative", 0) ? true : false;
+	data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
+	data->_offsetX = Json::getFloat(constraintMap, "x", 0) * _scale;
+	data->_offsetY = Json::getFloat(constraintMap, "y", 0) * _scale;
+	data->_offsetScaleX = Json::getFloat(constraintMap, "scaleX", 0);
+	data->_offsetScaleY = Json::getFloat(constraintMap, "scaleY", 0);
+	data->_offsetShearY = Json::getFloat(constraintMap, "shearY", 0);
+
+	data->_mixRotate = Json::getFloat(constraintMap, "mixRotate", 1);
+	data->_mixX = Json::getFloat(constraintMap, "mixX", 1);
+	data->_mixY = Json::getFloat(constraintMap, "mixY", data->_mixX);
+	data->_mixScaleX = Json::getFloat(constraintMap, "mixScaleX", 1);
+	data->_mixScaleY = Json::getFloat(constraintMap, "mixScaleY", data->_mixScaleX);
+	data->_mixShearY = Json::getFloat(constraintMap, "mixShearY", 1);
+
+	skeletonData->_transformConstraints.add(data);
+	return true;
+}
 
-			data->_x = Json::getFloat(constraintMap, "x", 0);
-			data->_y = Json::getFloat(constraintMap, "y", 0);
-			data->_rotate = Json::getFloat(constraintMap, "rotate", 0);
-			data->_scaleX = Json::getFloat(constraintMap, "scaleX", 0);
-			data->_shearX = Json::getFloat(constraintMap, "shearX", 0);
-			data->_limit = Json::getFloat(constraintMap, "limit", 5000) * _scale;
-			data->_step = 1.0f / Json::getInt(constraintMap, "fps", 60);
-			data->_inertia = Json::getFloat(constraintMap, "inertia", 1);
-			data->_strength = Json::getFloat(constraintMap, "strength", 100);
-			data->_damping = Json::getFloat(constraintMap, "damping", 1);
-			data->_massInverse = 1.0f / Json::getFloat(constraintMap, "mass", 1);
-			data->_wind = Json::getFloat(constraintMap, "wind", 0);
-			data->_gravity = Json::getFloat(constraintMap, "gravity", 0);
-			data->_mix = Json::getFloat(constraintMap, "mix", 1);
-			data->_inertiaGlobal = Json::getBoolean(constraintMap, "inertiaGlobal", false);
-			data->_strengthGlobal = Json::getBoolean(constraintMap, "strengthGlobal", false);
-			data->_dampingGlobal = Json::getBoolean(constraintMap, "dampingGlobal", false);
-			data->_massGlobal = Json::getBoolean(constraintMap, "massGlobal", false);
-			data->_windGlobal = Json::getBoolean(constraintMap, "windGlobal", false);
-			data->_gravityGlobal = Json::getBoolean(constraintMap, "gravityGlobal", false);
-			data->_mixGlobal = Json::getBoolean(constraintMap, "mixGlobal", false);
-
-			skeletonData->_physicsConstraints[i] = data;
+bool SkeletonJson::readPathConstraint(Json *constraintMap, SkeletonData *skeletonData) {
+	const char *name;
+	int ii;
+	const char *item;
+
+	PathConstraintData *data = new (__FILE__, __LINE__) PathConstraintData(
+			Json::getString(constraintMap, "name", 0));
+	data->setOrder(Json::getInt(constraintMap, "order", 0));
+	data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
+
+	Json *boneMap = Json::getItem(constraintMap, "bones");
+	data->_bones.ensureCapacity(boneMap->_size);
+	data->_bones.setSize(boneMap->_size, 0);
+	for (boneMap = boneMap->_child, ii = 0; boneMap; boneMap = boneMap->_next, ++ii) {
+		data->_bones[ii] = skeletonData->findBone(boneMap->_valueString);
+		if (!data->_bones[ii]) {
+			delete data;
+			setError(_error, "Path bone not found: ", boneMap->_valueString);
+			return false;
 		}
 	}
 
-	/* Skins. */
-	skins = Json::getItem(root, "skins");
-	if (skins) {
-		Json *skinMap;
-		skeletonData->_skins.ensureCapacity(skins->_size);
-		skeletonData->_skins.setSize(skins->_size, 0);
-		int skinsIndex = 0;
-		for (skinMap = skins->_child, i = 0; skinMap; skinMap = skinMap->_next, ++i) {
-			Json *attachmentsMap;
-			Json *curves;
-
-			Skin *skin = new (__FILE__, __LINE__) Skin(Json::getString(skinMap, "name", ""));
-
-			Json *item = Json::getItem(skinMap, "bones");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					BoneData *data = skeletonData->findBone(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin bone not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getBones().add(data);
-				}
-			}
+	name = Json::getString(constraintMap, "target", 0);
+	data->_target = skeletonData->findSlot(name);
+	if (!data->_target) {
+		delete data;
+		setError(_error, "Target slot not found: ", name);
+		return false;
+	}
 
-			item = Json::getItem(skinMap, "ik");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					IkConstraintData *data = skeletonData->findIkConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin IK constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
-				}
-			}
+	item = Json::getString(constraintMap, "positionMode", "percent");
+	if (strcmp(item, "fixed") == 0) {
+		data->_positionMode = PositionMode_Fixed;
+	} else if (strcmp(item, "percent") == 0) {
+		data->_positionMode = PositionMode_Percent;
+	}
 
-			item = Json::getItem(skinMap, "transform");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					TransformConstraintData *data = skeletonData->findTransformConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin transform constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
-				}
+	item = Json::getString(constraintMap, "spacingMode", "length");
+	if (strcmp(item, "length") == 0) data->_spacingMode = SpacingMode_Length;
+	else if (strcmp(item, "fixed") == 0)
+		data->_spacingMode = SpacingMode_Fixed;
+	else if (strcmp(item, "percent") == 0)
+		data->_spacingMode = SpacingMode_Percent;
+	else
+		data->_spacingMode = SpacingMode_Proportional;
+
+	item = Json::getString(constraintMap, "rotateMode", "tangent");
+	if (strcmp(item, "tangent") == 0) data->_rotateMode = RotateMode_Tangent;
+	else if (strcmp(item, "chain") == 0)
+		data->_rotateMode = RotateMode_Chain;
+	else if (strcmp(item, "chainScale") == 0)
+		data->_rotateMode = RotateMode_ChainScale;
+
+	data->_offsetRotation = Json::getFloat(constraintMap, "rotation", 0);
+	data->_position = Json::getFloat(constraintMap, "position", 0);
+	if (data->_positionMode == PositionMode_Fixed) data->_position *= _scale;
+	data->_spacing = Json::getFloat(constraintMap, "spacing", 0);
+	if (data->_spacingMode == SpacingMode_Length || data->_spacingMode == SpacingMode_Fixed)
+		data->_spacing *= _scale;
+	data->_mixRotate = Json::getFloat(constraintMap, "mixRotate", 1);
+	data->_mixX = Json::getFloat(constraintMap, "mixX", 1);
+	data->_mixY = Json::getFloat(constraintMap, "mixY", data->_mixX);
+
+	skeletonData->_pathConstraints.add(data);
+	return true;
+}
+
+bool SkeletonJson::readPhysicsConstraint(Json *constraintMap, SkeletonData *skeletonData) {
+	const char *name;
+
+	PhysicsConstraintData *data = new (__FILE__, __LINE__) PhysicsConstraintData(
+			Json::getString(constraintMap, "name", 0));
+	data->setOrder(Json::getInt(constraintMap, "order", 0));
+	data->setSkinRequired(Json::getBoolean(constraintMap, "skin", false));
+
+	name = Json::getString(constraintMap, "bone", 0);
+	data->_bone = skeletonData->findBone(name);
+	if (!data->_bone) {
+		delete data;
+		setError(_error, "Physics bone not found: ", name);
+		return false;
+	}
+
+	data->_x = Json::getFloat(constraintMap, "x", 0);
+	data->_y = Json::getFloat(constraintMap, "y", 0);
+	data->_rotate = Json::getFloat(constraintMap, "rotate", 0);
+	data->_scaleX = Json::getFloat(constraintMap, "scaleX", 0);
+	data->_shearX = Json::getFloat(constraintMap, "shearX", 0);
+	data->_limit = Json::getFloat(constraintMap, "limit", 5000) * _scale;
+	data->_step = 1.0f / Json::getInt(constraintMap, "fps", 60);
+	data->_inertia = Json::getFloat(constraintMap, "inertia", 1);
+	data->_strength = Json::getFloat(constraintMap, "strength", 100);
+	data->_damping = Json::getFloat(constraintMap, "damping", 1);
+	data->_massInverse = 1.0f / Json::getFloat(constraintMap, "mass", 1);
+	data->_wind = Json::getFloat(constraintMap, "wind", 0);
+	data->_gravity = Json::getFloat(constraintMap, "gravity", 0);
+	data->_mix = Json::getFloat(constraintMap, "mix", 1);
+	data->_inertiaGlobal = Json::getBoolean(constraintMap, "inertiaGlobal", false);
+	data->_strengthGlobal = Json::getBoolean(constraintMap, "strengthGlobal", false);
+	data->_dampingGlobal = Json::getBoolean(constraintMap, "dampingGlobal", false);
+	data->_massGlobal = Json::getBoolean(constraintMap, "massGlobal", false);
+	data->_windGlobal = Json::getBoolean(constraintMap, "windGlobal", false);
+	data->_gravityGlobal = Json::getBoolean(constraintMap, "gravityGlobal", false);
+	data->_mixGlobal = Json::getBoolean(constraintMap, "mixGlobal", false);
+
+	skeletonData->_physicsConstraints.add(data);
+	return true;
+}
+
+bool SkeletonJson::readSkin(Json *skinMap, SkeletonData *skeletonData) {
+	Json *attachmentsMap;
+	Json *curves;
+	int ii;
+
+	Skin *skin = new (__FILE__, __LINE__) Skin(Json::getString(skinMap, "name", ""));
+
+	Json *item = Json::getItem(skinMap, "bones");
+	if (item) {
+		for (item = item->_child; item; item = item->_next) {
+			BoneData *data = skeletonData->findBone(item->_valueString);
+			if (!data) {
+				delete skin;
+				setError(_error, String("Skin bone not found: "), item->_valueString);
+				return false;
 			}
+			skin->getBones().add(data);
+		}
+	}
 
-			item = Json::getItem(skinMap, "path");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					PathConstraintData *data = skeletonData->findPathConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin path constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
-				}
+	item = Json::getItem(skinMap, "ik");
+	if (item) {
+		for (item = item->_child; item; item = item->_next) {
+			IkConstraintData *data = skeletonData->findIkConstraint(item->_valueString);
+			if (!data) {
+				delete skin;
+				setError(_error, String("Skin IK constraint not found: "), item->_valueString);
+				return false;
 			}
+			skin->getConstraints().add(data);
+		}
+	}
 
-			item = Json::getItem(skinMap, "physics");
-			if (item) {
-				for (item = item->_child; item; item = item->_next) {
-					PhysicsConstraintData *data = skeletonData->findPhysicsConstraint(item->_valueString);
-					if (!data) {
-						delete skeletonData;
-						setError(root, String("Skin physics constraint not found: "), item->_valueString);
-						return NULL;
-					}
-					skin->getConstraints().add(data);
-				}
+	item = Json::getItem(skinMap, "transform");
+	if (item) {
+		for (item = item->_child; item; item = item->_next) {
+			TransformConstraintData *data = skeletonData->findTransformConstraint(item->_valueString);
+			if (!data) {
+				delete skin;
+				setError(_error, String("Skin transform constraint not found: "), item->_valueString);
+				return false;
 			}
+			skin->getConstraints().add(data);
+		}
+	}
 
-			skeletonData->_skins[skinsIndex++] = skin;
-			if (strcmp(Json::getString(skinMap, "name", ""), "default") == 0) {
-				skeletonData->_defaultSkin = skin;
+	item = Json::getItem(skinMap, "path");
+	if (item) {
+		for (item = item->_child; item; item = item->_next) {
+			PathConstraintData *data = skeletonData->findPathConstraint(item->_valueString);
+			if (!data) {
+				delete skin;
+				setError(_error, String("Skin path constraint not found: "), item->_valueString);
+				return false;
 			}
+			skin->getConstraints().add(data);
+		}
+	}
 
-			Json *attachments = Json::getItem(skinMap, "attachments");
-			if (attachments)
-				for (attachmentsMap = attachments->_child;
-					 attachmentsMap; attachmentsMap = attachmentsMap->_next) {
-					SlotData *slot = skeletonData->findSlot(attachmentsMap->_name);
-					Json *attachmentMap;
-
-					for (attachmentMap = attachmentsMap->_child; attachmentMap; attachmentMap = attachmentMap->_next) {
-						Attachment *attachment = NULL;
-						const char *skinAttachmentName = attachmentMap->_name;
-						const char *attachmentName = Json::getString(attachmentMap, "name", skinAttachmentName);
-						const char *attachmentPath = Json::getString(attachmentMap, "path", attachmentName);
-						const char *color;
-						Json *entry;
-
-						const char *typeString = Json::getString(attachmentMap, "type", "region");
-						AttachmentType type;
-						if (strcmp(typeString, "region") == 0) type = AttachmentType_Region;
-						else if (strcmp(typeString, "mesh") == 0)
-							type = AttachmentType_Mesh;
-						else if (strcmp(typeString, "linkedmesh") == 0)
-							type = AttachmentType_Linkedmesh;
-						else if (strcmp(typeString, "boundingbox") == 0)
-							type = AttachmentType_Boundingbox;
-						else if (strcmp(typeString, "path") == 0)
-							type = AttachmentType_Path;
-						else if (strcmp(typeString, "clipping") == 0)
-							type = AttachmentType_Clipping;
-						else if (strcmp(typeString, "point") == 0)
-							type = AttachmentType_Point;
-						else {
-							delete skeletonData;
-							setError(root, "Unknown attachment type: ", typeString);
-							return NULL;
-						}
+	item = Json::getItem(skinMap, "physics");
+	if (item) {
+		for (item = item->_child; item; item = item->_next) {
+			PhysicsConstraintData *data = skeletonData->findPhysicsConstraint(item->_valueString);
+			if (!data) {
+				delete skin;
+				setError(_error, String("Skin physics constraint not found: "), item->_valueString);
+				return false;
+			}
+			skin->getConstraints().add(data);
+		}
+	}
 
-						switch (type) {
-							case AttachmentType_Region: {
-								Sequence *sequence = readSequence(Json::getItem(attachmentMap, "sequence"));
-								attachment = _attachmentLoader->newRegionAttachment(*skin, attachmentName, attachmentPath, sequence);
-								if (!attachment) {
-									delete skeletonData;
-									setError(root, "Error reading attachment: ", skinAttachmentName);
-									return NULL;
-								}
+	skeletonData->_skins.add(skin);
+	if (strcmp(Json::getString(skinMap, "name", ""), "default") == 0) {
+		skeletonData->_defaultSkin = skin;
+	}
 
-								RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
-								region->_path = attachmentPath;
+	Json *attachments = Json::getItem(skinMap, "attachments");
+	if (attachments)
+		for (attachmentsMap = attachments->_child;
+			 attachmentsMap; attachmentsMap = attachmentsMap->_next) {
+			SlotData *slot = skeletonData->findSlot(attachmentsMap->_name);
+			Json *attachmentMap;
+
+			for (attachmentMap = attachmentsMap->_child; attachmentMap; attachmentMap = attachmentMap->_next) {
+				Attachment *attachment = NULL;
+				const char *skinAttachmentName = attachmentMap->_name;
+				const char *attachmentName = Json::getString(attachmentMap, "name", skinAttachmentName);
+				const char *attachmentPath = Json::getString(attachmentMap, "path", attachmentName);
+				const char *color;
+				Json *entry;
+
+				const char *typeString = Json::getString(attachmentMap, "type", "region");
+				AttachmentType type;
+				if (strcmp(typeString, "region") == 0) type = AttachmentType_Region;
+				else if (strcmp(typeString, "mesh") == 0)
+					type = AttachmentType_Mesh;
+				else if (strcmp(typeString, "linkedmesh") == 0)
+					type = AttachmentType_Linkedmesh;
+				else if (strcmp(typeString, "boundingbox") == 0)
+					type = AttachmentType_Boundingbox;
+				else if (strcmp(typeString, "path") == 0)
+					type = AttachmentType_Path;
+				else if (strcmp(typeString, "clipping") == 0)
+					type = AttachmentType_Clipping;
+				else if (strcmp(typeString, "point") == 0)
+					type = AttachmentType_Point;
+				else {
+					setError(_error, "Unknown attachment type: ", typeString);
+					return false;
+				}
 
-								region->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
-								region->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
-								region->_scaleX = Json::getFloat(attachmentMap, "scaleX", 1);
-								region->_scaleY = Json::getFloat(attachmentMap, "scaleY", 1);
-								region->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
-								region->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
-								region->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
-								region->_sequence = sequence;
+				switch (type) {
+					case AttachmentType_Region: {
+						Sequence *sequence = readSequence(Json::getItem(attachmentMap, "sequence"));
+						attachment = _attachmentLoader->newRegionAttachment(*skin, attachmentName, attachmentPath, sequence);
+						if (!attachment) {
+							setError(_error, "Error reading attachment: ", skinAttachmentName);
+							return false;
+						}
 
-								color = Json::getString(attachmentMap, "color", 0);
-								if (color) toColor(region->getColor(), color, true);
+						RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+						region->_path = attachmentPath;
 
-								if (region->_region != NULL) region->updateRegion();
-								_attachmentLoader->configureAttachment(region);
-								break;
-							}
-							case AttachmentType_Mesh:
-							case AttachmentType_Linkedmesh: {
-								Sequence *sequence = readSequence(Json::getItem(attachmentMap, "sequence"));
-								attachment = _attachmentLoader->newMeshAttachment(*skin, attachmentName, attachmentPath, sequence);
-
-								if (!attachment) {
-									delete skeletonData;
-									setError(root, "Error reading attachment: ", skinAttachmentName);
-									return NULL;
-								}
+						region->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
+						region->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
+						region->_scaleX = Json::getFloat(attachmentMap, "scaleX", 1);
+						region->_scaleY = Json::getFloat(attachmentMap, "scaleY", 1);
+						region->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
+						region->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
+						region->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
+						region->_sequence = sequence;
 
-								MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
-								mesh->_path = attachmentPath;
+						color = Json::getString(attachmentMap, "color", 0);
+						if (color) toColor(region->getColor(), color, true);
 
-								color = Json::getString(attachmentMap, "color", 0);
-								if (color) toColor(mesh->getColor(), color, true);
+						if (region->_region != NULL) region->updateRegion();
+						_attachmentLoader->configureAttachment(region);
+						break;
+					}
+					case AttachmentType_Mesh:
+					case AttachmentType_Linkedmesh: {
+						Sequence *sequence = readSequence(Json::getItem(attachmentMap, "sequence"));
+						attachment = _attachmentLoader->newMeshAttachment(*skin, attachmentName, attachmentPath, sequence);
+
+						if (!attachment) {
+							setError(_error, "Error reading attachment: ", skinAttachmentName);
+							return false;
+						}
 
-								mesh->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
-								mesh->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
-								mesh->_sequence = sequence;
+						MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+						mesh->_path = attachmentPath;
 
-								entry = Json::getItem(attachmentMap, "parent");
-								if (!entry) {
-									int verticesLength;
-									entry = Json::getItem(attachmentMap, "triangles");
-									mesh->_triangles.ensureCapacity(entry->_size);
-									mesh->_triangles.setSize(entry->_size, 0);
-									for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-										mesh->_triangles[ii] = (unsigned short) entry->_valueInt;
+						color = Json::getString(attachmentMap, "color", 0);
+						if (color) toColor(mesh->getColor(), color, true);
 
-									entry = Json::getItem(attachmentMap, "uvs");
-									verticesLength = entry->_size;
-									mesh->_regionUVs.ensureCapacity(verticesLength);
-									mesh->_regionUVs.setSize(verticesLength, 0);
-									for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-										mesh->_regionUVs[ii] = entry->_valueFloat;
+						mesh->_width = Json::getFloat(attachmentMap, "width", 32) * _scale;
+						mesh->_height = Json::getFloat(attachmentMap, "height", 32) * _scale;
+						mesh->_sequence = sequence;
 
-									readVertices(attachmentMap, mesh, verticesLength);
+						entry = Json::getItem(attachmentMap, "parent");
+						if (!entry) {
+							int verticesLength;
+							entry = Json::getItem(attachmentMap, "triangles");
+							mesh->_triangles.ensureCapacity(entry->_size);
+							mesh->_triangles.setSize(entry->_size, 0);
+							for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
+								mesh->_triangles[ii] = (unsigned short) entry->_valueInt;
 
-									if (mesh->_region != NULL) mesh->updateRegion();
+							entry = Json::getItem(attachmentMap, "uvs");
+							verticesLength = entry->_size;
+							mesh->_regionUVs.ensureCapacity(verticesLength);
+							mesh->_regionUVs.setSize(verticesLength, 0);
+							for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
+								mesh->_regionUVs[ii] = entry->_valueFloat;
 
-									mesh->_hullLength = Json::getInt(attachmentMap, "hull", 0);
+							readVertices(attachmentMap, mesh, verticesLength);
 
-									entry = Json::getItem(attachmentMap, "edges");
-									if (entry) {
-										mesh->_edges.ensureCapacity(entry->_size);
-										mesh->_edges.setSize(entry->_size, 0);
-										for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
-											mesh->_edges[ii] = entry->_valueInt;
-									}
-									_attachmentLoader->configureAttachment(mesh);
-								} else {
-									bool inheritTimelines = Json::getInt(attachmentMap, "timelines", 1) ? true : false;
-									LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh,
-																								 String(Json::getString(
-																										 attachmentMap,
-																										 "skin", 0)),
-																								 slot->getIndex(),
-																								 String(entry->_valueString),
-																								 inheritTimelines);
-									_linkedMeshes.add(linkedMesh);
-								}
-								break;
-							}
-							case AttachmentType_Boundingbox: {
-								attachment = _attachmentLoader->newBoundingBoxAttachment(*skin, attachmentName);
+							if (mesh->_region != NULL) mesh->updateRegion();
 
-								BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
+							mesh->_hullLength = Json::getInt(attachmentMap, "hull", 0);
 
-								int vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
-								readVertices(attachmentMap, box, vertexCount);
-								color = Json::getString(attachmentMap, "color", NULL);
-								if (color) toColor(box->getColor(), color, true);
-								_attachmentLoader->configureAttachment(attachment);
-								break;
-							}
-							case AttachmentType_Path: {
-								attachment = _attachmentLoader->newPathAttachment(*skin, attachmentName);
-
-								PathAttachment *pathAttatchment = static_cast<PathAttachment *>(attachment);
-
-								int vertexCount = 0;
-								pathAttatchment->_closed = Json::getInt(attachmentMap, "closed", 0) ? true : false;
-								pathAttatchment->_constantSpeed = Json::getInt(attachmentMap, "constantSpeed", 1) ? true
-																												  : false;
-								vertexCount = Json::getInt(attachmentMap, "vertexCount", 0);
-								readVertices(attachmentMap, pathAttatchment, vertexCount << 1);
-
-								pathAttatchment->_lengths.ensureCapacity(vertexCount / 3);
-								pathAttatchment->_lengths.setSize(vertexCount / 3, 0);
-
-								curves = Json::getItem(attachmentMap, "lengths");
-								for (curves = curves->_child, ii = 0; curves; curves = curves->_next, ++ii)
-									pathAttatchment->_lengths[ii] = curves->_valueFloat * _scale;
-								color = Json::getString(attachmentMap, "color", NULL);
-								if (color) toColor(pathAttatchment->getColor(), color, true);
-								_attachmentLoader->configureAttachment(attachment);
-								break;
+							entry = Json::getItem(attachmentMap, "edges");
+							if (entry) {
+								mesh->_edges.ensureCapacity(entry->_size);
+								mesh->_edges.setSize(entry->_size, 0);
+								for (entry = entry->_child, ii = 0; entry; entry = entry->_next, ++ii)
+									mesh->_edges[ii] = entry->_valueInt;
 							}
-							case AttachmentType_Point: {
-								attachment = _attachmentLoader->newPointAttachment(*skin, attachmentName);
+							_attachmentLoader->configureAttachment(mesh);
+						} else {
+							bool inheritTimelines = Json::getInt(attachmentMap, "timelines", 1) ? true : false;
+							/* Linked meshes belong to the loader, so they are never put in the skeleton data's arena. */
+							DataArena::Scope heap(NULL);
+							LinkedMesh *linkedMesh = new (__FILE__, __LINE__) LinkedMesh(mesh,
+																						 String(Json::getString(
+																								 attachmentMap,
+																								 "skin", 0)),
+																						 slot->getIndex(),
+																						 String(entry->_valueString),
+																						 inheritTimelines);
+							_linkedMeshes.add(linkedMesh);
+						}
+						break;
+					}
+					case AttachmentType_Boundingbox: {
+						attachment = _attachmentLoader->newBoundingBoxAttachment(*skin, attachmentName);
 
-								PointAttachment *point = static_cast<PointAttachment *>(attachment);
+						BoundingBoxAttachment *box = static_cast<BoundingBoxAttachment *>(attachment);
 
-								point->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
-								point->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
-								point->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
-								color = Json::getString(attachmentMap, "color", NULL);
-								if (color) toColor(point->getColor(), color, true);
-								_attachmentLoader->configureAttachment(attachment);
-								break;
-							}
-							case AttachmentType_Clipping: {
-								attachment = _attachmentLoader->newClippingAttachment(*skin, attachmentName);
-
-								ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
-
-								int vertexCount = 0;
-								const char *end = Json::getString(attachmentMap, "end", 0);
-								if (end) clip->_endSlot = skeletonData->findSlot(end);
-								vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
-								readVertices(attachmentMap, clip, vertexCount);
-								color = Json::getString(attachmentMap, "color", NULL);
-								if (color) toColor(clip->getColor(), color, true);
-								_attachmentLoader->configureAttachment(attachment);
-								break;
-							}
-						}
+						int vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
+						readVertices(attachmentMap, box, vertexCount);
+						color = Json::getString(attachmentMap, "color", NULL);
+						if (color) toColor(box->getColor(), color, true);
+						_attachmentLoader->configureAttachment(attachment);
+						break;
+					}
+					case AttachmentType_Path: {
+						attachment = _attachmentLoader->newPathAttachment(*skin, attachmentName);
+
+						PathAttachment *pathAttatchment = static_cast<PathAttachment *>(attachment);
+
+						int vertexCount = 0;
+						pathAttatchment->_closed = Json::getInt(attachmentMap, "closed", 0) ? true : false;
+						pathAttatchment->_constantSpeed = Json::getInt(attachmentMap, "constantSpeed", 1) ? true
+																										  : false;
+						vertexCount = Json::getInt(attachmentMap, "vertexCount", 0);
+						readVertices(attachmentMap, pathAttatchment, vertexCount << 1);
+
+						pathAttatchment->_lengths.ensureCapacity(vertexCount / 3);
+						pathAttatchment->_lengths.setSize(vertexCount / 3, 0);
+
+						curves = Json::getItem(attachmentMap, "lengths");
+						for (curves = curves->_child, ii = 0; curves; curves = curves->_next, ++ii)
+							pathAttatchment->_lengths[ii] = curves->_valueFloat * _scale;
+						color = Json::getString(attachmentMap, "color", NULL);
+						if (color) toColor(pathAttatchment->getColor(), color, true);
+						_attachmentLoader->configureAttachment(attachment);
+						break;
+					}
+					case AttachmentType_Point: {
+						attachment = _attachmentLoader->newPointAttachment(*skin, attachmentName);
 
-						skin->setAttachment(slot->getIndex(), skinAttachmentName, attachment);
+						PointAttachment *point = static_cast<PointAttachment *>(attachment);
+
+						point->_x = Json::getFloat(attachmentMap, "x", 0) * _scale;
+						point->_y = Json::getFloat(attachmentMap, "y", 0) * _scale;
+						point->_rotation = Json::getFloat(attachmentMap, "rotation", 0);
+						color = Json::getString(attachmentMap, "color", NULL);
+						if (color) toColor(point->getColor(), color, true);
+						_attachmentLoader->configureAttachment(attachment);
+						break;
+					}
+					case AttachmentType_Clipping: {
+						attachment = _attachmentLoader->newClippingAttachment(*skin, attachmentName);
+
+						ClippingAttachment *clip = static_cast<ClippingAttachment *>(attachment);
+
+						int vertexCount = 0;
+						const char *end = Json::getString(attachmentMap, "end", 0);
+						if (end) clip->_endSlot = skeletonData->findSlot(end);
+						vertexCount = Json::getInt(attachmentMap, "vertexCount", 0) << 1;
+						readVertices(attachmentMap, clip, vertexCount);
+						color = Json::getString(attachmentMap, "color", NULL);
+						if (color) toColor(clip->getColor(), color, true);
+						_attachmentLoader->configureAttachment(attachment);
+						break;
 					}
 				}
+
+				skin->setAttachment(slot->getIndex(), String::atom(skinAttachmentName), attachment);
+			}
 		}
+	return true;
+}
+
+bool SkeletonJson::readEvent(Json *eventMap, SkeletonData *skeletonData) {
+	EventData *eventData = new (__FILE__, __LINE__) EventData(String(eventMap->_name));
+
+	eventData->_intValue = Json::getInt(eventMap, "int", 0);
+	eventData->_floatValue = Json::getFloat(eventMap, "float", 0);
+	const char *stringValue = Json::getString(eventMap, "string", 0);
+	eventData->_stringValue = stringValue;
+	const char *audioPath = Json::getString(eventMap, "audio", 0);
+	eventData->_audioPath = audioPath;
+	if (audioPath) {
+		eventData->_volume = Json::getFloat(eventMap, "volume", 1);
+		eventData->_balance = Json::getFloat(eventMap, "balance", 0);
 	}
+	skeletonData->_events.add(eventData);
+	return true;
+}
 
-	/* Linked meshes. */
-	int n = (int) _linkedMeshes.size();
-	for (i = 0; i < n; ++i) {
+bool SkeletonJson::linkMeshes(SkeletonData *skeletonData) {
+	for (size_t i = 0, n = _linkedMeshes.size(); i < n; ++i) {
 		LinkedMesh *linkedMesh = _linkedMeshes[i];
 		Skin *skin = linkedMesh->_skin.length() == 0 ? skeletonData->getDefaultSkin() : skeletonData->findSkin(linkedMesh->_skin);
 		if (skin == NULL) {
-			delete skeletonData;
-			setError(root, "Skin not found: ", linkedMesh->_skin.buffer());
-			return NULL;
+			setError(_error, "Skin not found: ", linkedMesh->_skin.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+			return false;
 		}
 		Attachment *parent = skin->getAttachment(linkedMesh->_slotIndex, linkedMesh->_parent);
 		if (parent == NULL) {
-			delete skeletonData;
-			setError(root, "Parent mesh not found: ", linkedMesh->_parent.buffer());
-			return NULL;
+			setError(_error, "Parent mesh not found: ", linkedMesh->_parent.buffer());
+			ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
+			return false;
 		}
 		linkedMesh->_mesh->_timelineAttachment = linkedMesh->_inheritTimeline ? static_cast<VertexAttachment *>(parent)
 																			  : linkedMesh->_mesh;
@@ -805,52 +1234,7 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 		_attachmentLoader->configureAttachment(linkedMesh->_mesh);
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
-	_linkedMeshes.clear();
-
-	/* Events. */
-	events = Json::getItem(root, "events");
-	if (events) {
-		Json *eventMap;
-		skeletonData->_events.ensureCapacity(events->_size);
-		skeletonData->_events.setSize(events->_size, 0);
-		for (eventMap = events->_child, i = 0; eventMap; eventMap = eventMap->_next, ++i) {
-			EventData *eventData = new (__FILE__, __LINE__) EventData(String(eventMap->_name));
-
-			eventData->_intValue = Json::getInt(eventMap, "int", 0);
-			eventData->_floatValue = Json::getFloat(eventMap, "float", 0);
-			const char *stringValue = Json::getString(eventMap, "string", 0);
-			eventData->_stringValue = stringValue;
-			const char *audioPath = Json::getString(eventMap, "audio", 0);
-			eventData->_audioPath = audioPath;
-			if (audioPath) {
-				eventData->_volume = Json::getFloat(eventMap, "volume", 1);
-				eventData->_balance = Json::getFloat(eventMap, "balance", 0);
-			}
-			skeletonData->_events[i] = eventData;
-		}
-	}
-
-	/* Animations. */
-	animations = Json::getItem(root, "animations");
-	if (animations) {
-		Json *animationMap;
-		skeletonData->_animations.ensureCapacity(animations->_size);
-		skeletonData->_animations.setSize(animations->_size, 0);
-		int animationsIndex = 0;
-		for (animationMap = animations->_child; animationMap; animationMap = animationMap->_next) {
-			Animation *animation = readAnimation(animationMap, skeletonData);
-			if (!animation) {
-				delete skeletonData;
-				delete root;
-				return NULL;
-			}
-			skeletonData->_animations[animationsIndex++] = animation;
-		}
-	}
-
-	delete root;
-
-	return skeletonData;
+	return true;
 }
 
 Sequence *SkeletonJson::readSequence(Json *item) {
@@ -934,16 +1318,17 @@ Timeline *SkeletonJson::readTimeline(Json *keyMap, CurveTimeline2 *timeline, con
 	return timeline;
 }
 
-int SkeletonJson::findSlotIndex(SkeletonData *skeletonData, const String &slotName, Vector<Timeline *> timelines) {
-	int slotIndex = ContainerUtil::findIndexWithName(skeletonData->getSlots(), slotName);
+int SkeletonJson::findSlotIndex(SkeletonData *skeletonData, const String &slotName, Vector<Timeline *> timelines,
+								String &error) {
+	int slotIndex = skeletonData->_slotIndex.find(skeletonData->_slots, slotName);
 	if (slotIndex == -1) {
 		ContainerUtil::cleanUpVectorOfPointers(timelines);
-		setError(NULL, "Slot not found: ", slotName);
+		setError(error, "Slot not found: ", slotName);
 	}
 	return slotIndex;
 }
 
-Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
+Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData, String &error) {
 	Vector<Timeline *> timelines;
 	Json *bones = Json::getItem(root, "bones");
 	Json *slots = Json::getItem(root, "slots");
@@ -958,9 +1343,22 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	int frame, bezier;
 	Color color, color2, newColor, newColor2;
 
+	/* Every timeline is a value at the same depth, so the timelines vector can be allocated once. */
+	size_t timelineCount = (ik ? ik->_size : 0) + (transform ? transform->_size : 0) + (drawOrder ? 1 : 0) +
+						   (events ? 1 : 0);
+	Json *timelineMaps[] = {slots, bones, paths, physics};
+	for (int i = 0; i < 4; i++)
+		for (Json *map = timelineMaps[i] ? timelineMaps[i]->_child : 0; map; map = map->_next)
+			timelineCount += map->_size;
+	for (Json *skinMap = attachments ? attachments->_child : 0; skinMap; skinMap = skinMap->_next)
+		for (slotMap = skinMap->_child; slotMap; slotMap = slotMap->_next)
+			for (Json *attachmentMap = slotMap->_child; attachmentMap; attachmentMap = attachmentMap->_next)
+				timelineCount += attachmentMap->_size;
+	timelines.ensureCapacity(timelineCount);
+
 	/** Slot timelines. */
 	for (slotMap = slots ? slots->_child : 0; slotMap; slotMap = slotMap->_next) {
-		int slotIndex = findSlotIndex(skeletonData, slotMap->_name, timelines);
+		int slotIndex = findSlotIndex(skeletonData, slotMap->_name, timelines, error);
 		if (slotIndex == -1) return NULL;
 
 		for (Json *timelineMap = slotMap->_child; timelineMap; timelineMap = timelineMap->_next) {
@@ -968,8 +1366,9 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 			if (strcmp(timelineMap->_name, "attachment") == 0) {
 				AttachmentTimeline *timeline = new (__FILE__, __LINE__) AttachmentTimeline(frames, slotIndex);
 				for (keyMap = timelineMap->_child, frame = 0; keyMap; keyMap = keyMap->_next, ++frame) {
+					Json *name = Json::getItem(keyMap, "name");
 					timeline->setFrame(frame, Json::getFloat(keyMap, "time", 0),
-									   Json::getItem(keyMap, "name") ? Json::getItem(keyMap, "name")->_valueString : NULL);
+									   name ? String::atom(name->_valueString) : String());
 				}
 				timelines.add(timeline);
 
@@ -1097,7 +1496,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				timelines.add(timeline);
 			} else {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Invalid timeline type for a slot: ", timelineMap->_name);
+				setError(error, "Invalid timeline type for a slot: ", timelineMap->_name);
 				return NULL;
 			}
 		}
@@ -1105,10 +1504,10 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 
 	/** Bone timelines. */
 	for (boneMap = bones ? bones->_child : 0; boneMap; boneMap = boneMap->_next) {
-		int boneIndex = ContainerUtil::findIndexWithName(skeletonData->_bones, boneMap->_name);
+		int boneIndex = skeletonData->_boneIndex.find(skeletonData->_bones, String(boneMap->_name));
 		if (boneIndex == -1) {
 			ContainerUtil::cleanUpVectorOfPointers(timelines);
-			setError(NULL, "Bone not found: ", boneMap->_name);
+			setError(error, "Bone not found: ", boneMap->_name);
 			return NULL;
 		}
 
@@ -1180,7 +1579,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 				timelines.add(timeline);
 			} else {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Invalid timeline type for a bone: ", timelineMap->_name);
+				setError(error, "Invalid timeline type for a bone: ", timelineMap->_name);
 				return NULL;
 			}
 		}
@@ -1191,8 +1590,8 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		keyMap = constraintMap->_child;
 		if (keyMap == NULL) continue;
 
-		IkConstraintData *constraint = skeletonData->findIkConstraint(constraintMap->_name);
-		int constraintIndex = skeletonData->_ikConstraints.indexOf(constraint);
+		int constraintIndex = skeletonData->_ikConstraintIndex.find(skeletonData->_ikConstraints,
+																	 String(constraintMap->_name));
 		IkConstraintTimeline *timeline = new (__FILE__, __LINE__) IkConstraintTimeline(constraintMap->_size,
 																					   constraintMap->_size << 1,
 																					   constraintIndex);
@@ -1234,8 +1633,8 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 		keyMap = constraintMap->_child;
 		if (keyMap == NULL) continue;
 
-		TransformConstraintData *constraint = skeletonData->findTransformConstraint(constraintMap->_name);
-		int constraintIndex = skeletonData->_transformConstraints.indexOf(constraint);
+		int constraintIndex = skeletonData->_transformConstraintIndex.find(skeletonData->_transformConstraints,
+																			String(constraintMap->_name));
 		TransformConstraintTimeline *timeline = new (__FILE__, __LINE__) TransformConstraintTimeline(
 				constraintMap->_size, constraintMap->_size * 6, constraintIndex);
 
@@ -1287,13 +1686,14 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 
 	/** Path constraint timelines. */
 	for (Json *constraintMap = paths ? paths->_child : 0; constraintMap; constraintMap = constraintMap->_next) {
-		PathConstraintData *constraint = skeletonData->findPathConstraint(constraintMap->_name);
-		if (!constraint) {
+		int constraintIndex = skeletonData->_pathConstraintIndex.find(skeletonData->_pathConstraints,
+																	   String(constraintMap->_name));
+		if (constraintIndex == -1) {
 			ContainerUtil::cleanUpVectorOfPointers(timelines);
-			setError(NULL, "Path constraint not found: ", constraintMap->_name);
+			setError(error, "Path constraint not found: ", constraintMap->_name);
 			return NULL;
 		}
-		int constraintIndex = skeletonData->_pathConstraints.indexOf(constraint);
+		PathConstraintData *constraint = skeletonData->_pathConstraints[constraintIndex];
 		for (Json *timelineMap = constraintMap->_child; timelineMap; timelineMap = timelineMap->_next) {
 			keyMap = timelineMap->_child;
 			if (keyMap == NULL) continue;
@@ -1351,13 +1751,13 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	for (Json *constraintMap = physics ? physics->_child : 0; constraintMap; constraintMap = constraintMap->_next) {
 		int index = -1;
 		if (constraintMap->_name && strlen(constraintMap->_name) > 0) {
-			PhysicsConstraintData *constraint = skeletonData->findPhysicsConstraint(constraintMap->_name);
-			if (!constraint) {
+			index = skeletonData->_physicsConstraintIndex.find(skeletonData->_physicsConstraints,
+																String(constraintMap->_name));
+			if (index == -1) {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Physics constraint not found: ", constraintMap->_name);
+				setError(error, "Physics constraint not found: ", constraintMap->_name);
 				return NULL;
 			}
-			index = skeletonData->_physicsConstraints.indexOf(constraint);
 		}
 		for (Json *timelineMap = constraintMap->_child; timelineMap; timelineMap = timelineMap->_next) {
 			keyMap = timelineMap->_child;
@@ -1399,14 +1799,14 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 	for (Json *attachmenstMap = attachments ? attachments->_child : NULL; attachmenstMap; attachmenstMap = attachmenstMap->_next) {
 		Skin *skin = skeletonData->findSkin(attachmenstMap->_name);
 		for (slotMap = attachmenstMap->_child; slotMap; slotMap = slotMap->_next) {
-			int slotIndex = findSlotIndex(skeletonData, slotMap->_name, timelines);
+			int slotIndex = findSlotIndex(skeletonData, slotMap->_name, timelines, error);
 			if (slotIndex == -1) return NULL;
 
 			for (Json *attachmentMap = slotMap->_child; attachmentMap; attachmentMap = attachmentMap->_next) {
 				Attachment *attachment = skin->getAttachment(slotIndex, attachmentMap->_name);
 				if (!attachment) {
 					ContainerUtil::cleanUpVectorOfPointers(timelines);
-					setError(NULL, "Attachment not found: ", attachmentMap->_name);
+					setError(error, "Attachment not found: ", attachmentMap->_name);
 					return NULL;
 				}
 
@@ -1424,9 +1824,10 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 						DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(frames,
 																						   frames, slotIndex, vertexAttachment);
 						float time = Json::getFloat(keyMap, "time", 0);
+						Vector<float> deformed;
 						for (frame = 0, bezier = 0;; frame++) {
 							Json *vertices = Json::getItem(keyMap, "vertices");
-							Vector<float> deformed;
+							deformed.clear();
 							if (!vertices) {
 								if (weighted) {
 									deformed.setSize(deformLength, 0);
@@ -1514,7 +1915,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 					drawOrder2[ii] = -1;
 
 				for (offsetMap = offsets->_child; offsetMap; offsetMap = offsetMap->_next) {
-					int slotIndex = findSlotIndex(skeletonData, Json::getString(offsetMap, "slot", 0), timelines);
+					int slotIndex = findSlotIndex(skeletonData, Json::getString(offsetMap, "slot", 0), timelines, error);
 					if (slotIndex == -1) return NULL;
 
 					/* Collect unchanged items. */
@@ -1545,7 +1946,7 @@ Animation *SkeletonJson::readAnimation(Json *root, SkeletonData *skeletonData) {
 			EventData *eventData = skeletonData->findEvent(Json::getString(keyMap, "name", 0));
 			if (!eventData) {
 				ContainerUtil::cleanUpVectorOfPointers(timelines);
-				setError(NULL, "Event not found: ", Json::getString(keyMap, "name", 0));
+				setError(error, "Event not found: ", Json::getString(keyMap, "name", 0));
 				return NULL;
 			}
 
@@ -1612,6 +2013,12 @@ void SkeletonJson::readVertices(Json *attachmentMap, VertexAttachment *attachmen
 }
 
 void SkeletonJson::setError(Json *root, const String &value1, const String &value2) {
-	_error = String(value1).append(value2);
+	setError(_error, value1, value2);
 	delete root;
 }
+
+void SkeletonJson::setError(String &error, const String &value1, const String &value2) {
+	/* Errors outlive the skeleton data, which is deleted when reading fails. */
+	DataArena::Scope heap(NULL);
+	error = String(value1).append(value2);
+}
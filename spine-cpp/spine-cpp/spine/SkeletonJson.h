@@ -61,7 +61,13 @@ namespace spine {
 
 	class Sequence;
 
+	class TaskScheduler;
+
+	class JsonAnimationDecoder;
+
 	class SP_API SkeletonJson : public SpineObject {
+		friend class JsonAnimationDecoder;
+
 	public:
 		explicit SkeletonJson(Atlas *atlas);
 
@@ -75,6 +81,30 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// Decodes animations in parallel using the given scheduler, or serially if NULL. The scheduler is not
+		/// owned and must outlive this loader.
+		void setTaskScheduler(TaskScheduler *taskScheduler);
+
+		/// Decodes animations in parallel on the given number of threads, or serially if 1 or less.
+		void setThreadCount(int threadCount);
+
+		/// When true, animations are not decoded when the skeleton data is read. Their JSON is kept and each
+		/// animation is decoded the first time it is needed, see SkeletonData::getAnimationDecoder().
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
+		/// When true, the skeleton data is read without building a Json document for the whole file. Each bone, slot,
+		/// constraint, skin, event and animation is parsed and read on its own, so memory use is bounded by the
+		/// largest item rather than the file size. Linked meshes are resolved after all skins are read.
+		void setStreaming(bool streaming) { _streaming = streaming; }
+
+		/// When true, the bones, slots, skins, attachments, animations and all other objects of the skeleton data are
+		/// allocated from its arena, see SkeletonData::getArena(). Timelines are then laid out next to each other and
+		/// destroying the objects doesn't free their memory one by one. The attachment loader must not keep memory it
+		/// allocates while reading.
+		void setUseArena(bool useArena) { _useArena = useArena; }
+
+		bool getUseArena() { return _useArena; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -83,6 +113,66 @@ namespace spine {
 		float _scale;
 		const bool _ownsLoader;
 		String _error;
+		TaskScheduler *_taskScheduler;
+		bool _ownsTaskScheduler;
+		bool _lazyAnimations;
+		bool _streaming;
+		bool _useArena;
+
+		/// The top level arrays or objects with one item per element, in the order they are read.
+		enum Section {
+			Section_Bones,
+			Section_Slots,
+			Section_Ik,
+			Section_Transform,
+			Section_Path,
+			Section_Physics,
+			Section_Skins,
+			Section_Events,
+			Section_Count
+		};
+
+		static const char *const _sectionNames[Section_Count];
+
+		explicit SkeletonJson(float scale);
+
+		/// Reads into the skeleton data while its arena is installed. On failure the caller deletes the skeleton data
+		/// after these return, when the locals allocated from the arena are gone.
+		bool readSkeletonData(const char *json, SkeletonData *skeletonData);
+
+		bool readSkeletonDataStreaming(const char *json, SkeletonData *skeletonData);
+
+		bool readSkeleton(Json *skeleton, SkeletonData *skeletonData);
+
+		bool readBone(Json *boneMap, SkeletonData *skeletonData);
+
+		bool readSlot(Json *slotMap, SkeletonData *skeletonData);
+
+		bool readIkConstraint(Json *constraintMap, SkeletonData *skeletonData);
+
+		bool readTransformConstraint(Json *constraintMap, SkeletonData *skeletonData);
+
+		bool readPathConstraint(Json *constraintMap, SkeletonData *skeletonData);
+
+		bool readPhysicsConstraint(Json *constraintMap, SkeletonData *skeletonData);
+
+		bool readSkin(Json *skinMap, SkeletonData *skeletonData);
+
+		bool readEvent(Json *eventMap, SkeletonData *skeletonData);
+
+		/// Reads one item of the section with the reader for that section.
+		bool readItem(int section, Json *map, SkeletonData *skeletonData);
+
+		/// Returns the unescaped key of an object member, from its opening quote to the end of the text.
+		static String readKey(const char *start, const char *end, Vector<char> &buffer);
+
+		bool linkMeshes(SkeletonData *skeletonData);
+
+		/// Creates the skeleton data's animations without timelines and a decoder that keeps a copy of the text of the
+		/// "animations" object, from its opening brace to end. Returns false if the object is malformed.
+		bool readLazyAnimations(const char *animations, const char *end, SkeletonData *skeletonData);
+
+		static void readAnimationTask(int index, void *userData);
 
 		static Sequence *readSequence(Json *sequence);
 
@@ -101,13 +191,16 @@ namespace spine {
 		readTimeline(Json *keyMap, CurveTimeline2 *timeline, const char *name1, const char *name2, float defaultValue,
 					 float scale);
 
-		Animation *readAnimation(Json *root, SkeletonData *skeletonData);
+		Animation *readAnimation(Json *root, SkeletonData *skeletonData, String &error);
 
 		void readVertices(Json *attachmentMap, VertexAttachment *attachment, size_t verticesLength);
 
 		void setError(Json *root, const String &value1, const String &value2);
 
-		int findSlotIndex(SkeletonData *skeletonData, const String &slotName, Vector<Timeline *> timelines);
+		static void setError(String &error, const String &value1, const String &value2);
+
+		int findSlotIndex(SkeletonData *skeletonData, const String &slotName, Vector<Timeline *> timelines,
+						  String &error);
 	};
 }
 
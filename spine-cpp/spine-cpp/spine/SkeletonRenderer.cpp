@@ -35,10 +35,13 @@
 #include <spine/MeshAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Bone.h>
+#include <spine/FrameArena.h>
 
 using namespace spine;
 
-SkeletonRenderer::SkeletonRenderer() : _allocator(4096), _worldVertices(), _quadIndices(), _clipping(), _renderCommands() {
+SkeletonRenderer::SkeletonRenderer() : _allocator(4096), _worldVertices(), _quadIndices(), _clipping(), _renderCommands(),
+										 _staticBuffers(false), _useFrameArena(false), _reuseCommands(false), _cacheValid(false), _reused(false), _transformed(false),
+										 _cachedSkeleton(NULL), _cachedCommands(NULL) {
 	_quadIndices.add(0);
 	_quadIndices.add(1);
 	_quadIndices.add(2);
@@ -50,22 +53,27 @@ SkeletonRenderer::SkeletonRenderer() : _allocator(4096), _worldVertices(), _quad
 SkeletonRenderer::~SkeletonRenderer() {
 }
 
-static RenderCommand *createRenderCommand(BlockAllocator &allocator, int numVertices, int32_t numIndices, BlendMode blendMode, void *texture) {
+static RenderCommand *createRenderCommand(BlockAllocator &allocator, int numVertices, int32_t numIndices, BlendMode blendMode, void *texture, bool allocateBuffers = true) {
 	RenderCommand *cmd = allocator.allocate<RenderCommand>(1);
 	cmd->positions = allocator.allocate<float>(numVertices << 1);
-	cmd->uvs = allocator.allocate<float>(numVertices << 1);
+	cmd->uvs = allocateBuffers ? allocator.allocate<float>(numVertices << 1) : nullptr;
 	cmd->colors = allocator.allocate<uint32_t>(numVertices);
 	cmd->darkColors = allocator.allocate<uint32_t>(numVertices);
 	cmd->numVertices = numVertices;
-	cmd->indices = allocator.allocate<uint16_t>(numIndices);
+	cmd->indices = allocateBuffers ? allocator.allocate<uint16_t>(numIndices) : nullptr;
 	cmd->numIndices = numIndices;
 	cmd->blendMode = blendMode;
 	cmd->texture = texture;
+	cmd->buffersOwner = nullptr;
+	cmd->buffersVersion = 0;
 	cmd->next = nullptr;
 	return cmd;
 }
 
+/* Merges the commands into one, copying their vertices and rebasing their indices. Commands referencing static buffers
+ * are copied too, only a command that is not merged keeps referencing its attachment's buffers. */
 static RenderCommand *batchSubCommands(BlockAllocator &allocator, Vector<RenderCommand *> &commands, int first, int last, int numVertices, int numIndices) {
+	if (first == last) return commands[first];
 	RenderCommand *batched = createRenderCommand(allocator, numVertices, numIndices, commands[first]->blendMode, commands[first]->texture);
 	float *positions = batched->positions;
 	float *uvs = batched->uvs;
@@ -137,7 +145,19 @@ static RenderCommand *batchCommands(BlockAllocator &allocator, Vector<RenderComm
 }
 
 RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
-	_allocator.compress();
+	if (_reuseCommands) {
+		captureState(skeleton);
+		if (_cacheValid && _cachedSkeleton == &skeleton && reuseCommands()) {
+			_reused = true;
+			return _cachedCommands;
+		}
+	}
+	_cacheValid = false;
+	_reused = false;
+
+	FrameArena *arena = _useFrameArena ? FrameArena::getCurrent() : NULL;
+	BlockAllocator &allocator = arena ? arena->getAllocator() : _allocator;
+	if (!arena) _allocator.compress();
 	_renderCommands.clear();
 
 	SkeletonClipping &clipper = _clipping;
@@ -165,6 +185,7 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 		int32_t indicesCount;
 		Color *attachmentColor;
 		void *texture;
+		int32_t uvsVersion;
 
 		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
 			RegionAttachment *regionAttachment = (RegionAttachment *) attachment;
@@ -183,6 +204,7 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 			indices = quadIndices;
 			indicesCount = 6;
 			texture = regionAttachment->getRegion()->rendererObject;
+			uvsVersion = regionAttachment->getUVsVersion();
 
 		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
 			MeshAttachment *mesh = (MeshAttachment *) attachment;
@@ -201,6 +223,7 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 			indices = &mesh->getTriangles();
 			indicesCount = (int32_t) indices->size();
 			texture = mesh->getRegion()->rendererObject;
+			uvsVersion = mesh->getUVsVersion();
 
 		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
 			ClippingAttachment *clip = (ClippingAttachment *) slot.getAttachment();
@@ -229,18 +252,197 @@ RenderCommand *SkeletonRenderer::render(Skeleton &skeleton) {
 			indicesCount = (int32_t) (clipper.getClippedTriangles().size());
 		}
 
-		RenderCommand *cmd = createRenderCommand(_allocator, verticesCount, indicesCount, slot.getData().getBlendMode(), texture);
+		bool staticBuffers = _staticBuffers && !clipper.isClipping();
+		RenderCommand *cmd = createRenderCommand(allocator, verticesCount, indicesCount, slot.getData().getBlendMode(), texture, !staticBuffers);
 		_renderCommands.add(cmd);
 		memcpy(cmd->positions, vertices->buffer(), (verticesCount << 1) * sizeof(float));
-		memcpy(cmd->uvs, uvs->buffer(), (verticesCount << 1) * sizeof(float));
 		for (int ii = 0; ii < verticesCount; ii++) {
 			cmd->colors[ii] = color;
 			cmd->darkColors[ii] = darkColor;
 		}
-		memcpy(cmd->indices, indices->buffer(), indices->size() * sizeof(uint16_t));
+		if (staticBuffers) {
+			cmd->uvs = uvs->buffer();
+			cmd->indices = indices->buffer();
+			cmd->buffersOwner = attachment;
+			cmd->buffersVersion = uvsVersion;
+		} else {
+			memcpy(cmd->uvs, uvs->buffer(), (verticesCount << 1) * sizeof(float));
+			memcpy(cmd->indices, indices->buffer(), indices->size() * sizeof(uint16_t));
+		}
 		clipper.clipEnd(slot);
 	}
 	clipper.clipEnd();
 
-	return batchCommands(_allocator, _renderCommands);
+	RenderCommand *commands = batchCommands(allocator, _renderCommands);
+	if (_reuseCommands && !arena) cacheCommands(skeleton, commands);
+	return commands;
+}
+
+bool SkeletonRenderer::getReuseCommands() {
+	return _reuseCommands;
+}
+
+void SkeletonRenderer::setReuseCommands(bool inValue) {
+	_reuseCommands = inValue;
+	_cacheValid = false;
+}
+
+bool SkeletonRenderer::getStaticBuffers() {
+	return _staticBuffers;
+}
+
+void SkeletonRenderer::setStaticBuffers(bool inValue) {
+	_staticBuffers = inValue;
+	_cacheValid = false;
+}
+
+bool SkeletonRenderer::getUseFrameArena() {
+	return _useFrameArena;
+}
+
+void SkeletonRenderer::setUseFrameArena(bool inValue) {
+	_useFrameArena = inValue;
+	_cacheValid = false;
+}
+
+const BlockAllocator::Stats &SkeletonRenderer::getAllocatorStats() {
+	return _allocator.getStats();
+}
+
+void SkeletonRenderer::invalidate() {
+	_cacheValid = false;
+}
+
+bool SkeletonRenderer::wasReused() {
+	return _reused;
+}
+
+void SkeletonRenderer::captureState(Skeleton &skeleton) {
+	Vector<Bone *> &bones = skeleton.getBones();
+	_boneState.setSize(bones.size() * 7, 0);
+	float *boneState = _boneState.buffer();
+	for (size_t i = 0, n = bones.size(); i < n; i++, boneState += 7) {
+		Bone &bone = *bones[i];
+		boneState[0] = bone.getA();
+		boneState[1] = bone.getB();
+		boneState[2] = bone.getC();
+		boneState[3] = bone.getD();
+		boneState[4] = bone.getWorldX();
+		boneState[5] = bone.getWorldY();
+		boneState[6] = bone.isActive() ? 1.0f : 0.0f;
+	}
+
+	Vector<Slot *> &drawOrder = skeleton.getDrawOrder();
+	Color &skeletonColor = skeleton.getColor();
+	_slotRefs.clear();
+	_slotState.clear();
+	_slotState.add(skeletonColor.r);
+	_slotState.add(skeletonColor.g);
+	_slotState.add(skeletonColor.b);
+	_slotState.add(skeletonColor.a);
+	for (size_t i = 0, n = drawOrder.size(); i < n; i++) {
+		Slot &slot = *drawOrder[i];
+		Attachment *attachment = slot.getAttachment();
+		_slotRefs.add(&slot);
+		_slotRefs.add(attachment);
+		if (!attachment) continue;
+
+		Color &color = slot.getColor();
+		_slotState.add(color.r);
+		_slotState.add(color.g);
+		_slotState.add(color.b);
+		_slotState.add(color.a);
+		if (slot.hasDarkColor()) {
+			Color &darkColor = slot.getDarkColor();
+			_slotState.add(darkColor.r);
+			_slotState.add(darkColor.g);
+			_slotState.add(darkColor.b);
+		}
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			Color &attachmentColor = ((RegionAttachment *) attachment)->getColor();
+			_slotState.add(attachmentColor.r);
+			_slotState.add(attachmentColor.g);
+			_slotState.add(attachmentColor.b);
+			_slotState.add(attachmentColor.a);
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			Color &attachmentColor = ((MeshAttachment *) attachment)->getColor();
+			_slotState.add(attachmentColor.r);
+			_slotState.add(attachmentColor.g);
+			_slotState.add(attachmentColor.b);
+			_slotState.add(attachmentColor.a);
+		}
+		_slotState.add((float) slot.getSequenceIndex());
+		Vector<float> &deform = slot.getDeform();
+		_slotState.add((float) deform.size());
+		for (size_t ii = 0, nn = deform.size(); ii < nn; ii++)
+			_slotState.add(deform[ii]);
+	}
+}
+
+static bool nearlyEqual(float a, float b) {
+	return MathUtil::abs(a - b) <= 0.0001f * (1 + MathUtil::abs(b));
+}
+
+bool SkeletonRenderer::reuseCommands() {
+	if (_slotRefs != _cachedSlotRefs || _slotState != _cachedSlotState) return false;
+	if (_boneState.size() != _cachedBoneState.size() || _boneState.size() == 0) return false;
+	bool identity = _boneState == _cachedBoneState;
+	if (identity && !_transformed) return true;
+
+	// Find the affine transform m mapping the cached root bone world transform to the current one.
+	float *cached = _cachedBoneState.buffer(), *current = _boneState.buffer();
+	float a = cached[0], b = cached[1], c = cached[2], d = cached[3], x = cached[4], y = cached[5];
+	float det = a * d - b * c;
+	if (det == 0) return false;
+	float invDet = 1 / det;
+	float ia = d * invDet, ib = -b * invDet, ic = -c * invDet, id = a * invDet;
+	float ix = (b * y - d * x) * invDet, iy = (c * x - a * y) * invDet;
+	float ra = current[0], rb = current[1], rc = current[2], rd = current[3], rx = current[4], ry = current[5];
+	float ma = ra * ia + rb * ic, mb = ra * ib + rb * id;
+	float mc = rc * ia + rd * ic, md = rc * ib + rd * id;
+	float mx = ra * ix + rb * iy + rx, my = rc * ix + rd * iy + ry;
+
+	if (identity) {
+		ma = md = 1;
+		mb = mc = mx = my = 0;
+	} else {
+		for (size_t i = 0, n = _boneState.size(); i < n; i += 7) {
+			float *from = cached + i, *to = current + i;
+			if (from[6] != to[6]) return false;
+			if (!nearlyEqual(ma * from[0] + mb * from[2], to[0]) || !nearlyEqual(ma * from[1] + mb * from[3], to[1]) ||
+				!nearlyEqual(mc * from[0] + md * from[2], to[2]) || !nearlyEqual(mc * from[1] + md * from[3], to[3]) ||
+				!nearlyEqual(ma * from[4] + mb * from[5] + mx, to[4]) || !nearlyEqual(mc * from[4] + md * from[5] + my, to[5]))
+				return false;
+		}
+	}
+
+	// Transform from the positions the commands were built with so repeated moves do not accumulate error.
+	float *positions = _cachedPositions.buffer();
+	for (RenderCommand *cmd = _cachedCommands; cmd; cmd = cmd->next) {
+		float *out = cmd->positions;
+		for (int i = 0, n = cmd->numVertices << 1; i < n; i += 2) {
+			float px = positions[i], py = positions[i + 1];
+			out[i] = ma * px + mb * py + mx;
+			out[i + 1] = mc * px + md * py + my;
+		}
+		positions += cmd->numVertices << 1;
+	}
+	_transformed = !identity;
+	return true;
+}
+
+void SkeletonRenderer::cacheCommands(Skeleton &skeleton, RenderCommand *commands) {
+	_cachedBoneState = _boneState;
+	_cachedSlotState = _slotState;
+	_cachedSlotRefs = _slotRefs;
+	_cachedPositions.clear();
+	for (RenderCommand *cmd = commands; cmd; cmd = cmd->next) {
+		size_t offset = _cachedPositions.size();
+		_cachedPositions.setSize(offset + (cmd->numVertices << 1), 0);
+		memcpy(_cachedPositions.buffer() + offset, cmd->positions, sizeof(float) * (cmd->numVertices << 1));
+	}
+	_cachedSkeleton = &skeleton;
+	_cachedCommands = commands;
+	_transformed = false;
+	_cacheValid = true;
 }
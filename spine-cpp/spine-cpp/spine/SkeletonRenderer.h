@@ -47,6 +47,10 @@ namespace spine {
         int32_t numIndices;
         BlendMode blendMode;
         void *texture;
+        /// Non-NULL if uvs and indices are not per frame copies but arrays owned by this attachment, see
+        /// SkeletonRenderer::setStaticBuffers(). Together with buffersVersion it identifies their contents.
+        void *buffersOwner;
+        int32_t buffersVersion;
         RenderCommand *next;
     };
 
@@ -57,12 +61,64 @@ namespace spine {
         ~SkeletonRenderer();
 
         RenderCommand *render(Skeleton &skeleton);
+
+        /// When enabled, render() compares the skeleton's bone world transforms, draw order, attachments, colors
+        /// and deforms against the state the previous commands were built from. If nothing changed, the previous
+        /// commands are returned as is. If the bones only moved by a common affine transform of the root bone,
+        /// that transform is applied to the previous positions instead of rebuilding the commands.
+        bool getReuseCommands();
+
+        void setReuseCommands(bool inValue);
+
+        /// Forces the next render() to rebuild its commands, e.g. after changing an attachment's region or UVs.
+        void invalidate();
+
+        /// Whether the commands returned by the last render() were reused rather than rebuilt.
+        bool wasReused();
+
+        /// When enabled, commands for unclipped region and mesh attachments reference the attachment's UVs and
+        /// triangle indices instead of copying them. Commands that are merged with their neighbors still copy them,
+        /// as merging rebases the indices, so only a command drawn on its own keeps the reference. The arrays only
+        /// change when the attachment's region is updated, which changes RenderCommand::buffersVersion, so a backend
+        /// can keep them in long lived buffers keyed by RenderCommand::buffersOwner.
+        bool getStaticBuffers();
+
+        void setStaticBuffers(bool inValue);
+
+        /// When enabled and a FrameArena is installed on the calling thread, render() allocates the commands from
+        /// the arena instead of from memory owned by this renderer, so many renderers share one buffer. The commands
+        /// then stay valid until the arena is reset, and are not reused by later render() calls.
+        bool getUseFrameArena();
+
+        void setUseFrameArena(bool inValue);
+
+        /// Statistics of the memory the commands are allocated from, when not using a FrameArena.
+        const BlockAllocator::Stats &getAllocatorStats();
     private:
         BlockAllocator _allocator;
         Vector<float> _worldVertices;
         Vector<unsigned short> _quadIndices;
         SkeletonClipping _clipping;
         Vector<RenderCommand *> _renderCommands;
+
+        bool _staticBuffers;
+        bool _useFrameArena;
+        bool _reuseCommands;
+        bool _cacheValid;
+        bool _reused;
+        bool _transformed;
+        Skeleton *_cachedSkeleton;
+        RenderCommand *_cachedCommands;
+        Vector<float> _boneState, _cachedBoneState;
+        Vector<float> _slotState, _cachedSlotState;
+        Vector<void *> _slotRefs, _cachedSlotRefs;
+        Vector<float> _cachedPositions;
+
+        void captureState(Skeleton &skeleton);
+
+        bool reuseCommands();
+
+        void cacheCommands(Skeleton &skeleton, RenderCommand *commands);
     };
 }
 
@@ -0,0 +1,356 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SpineAssetCache.h>
+
+#include <spine/AnimationStateData.h>
+#include <spine/Atlas.h>
+#include <spine/Extension.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/SkeletonJson.h>
+
+#include <ctype.h>
+#include <stdint.h>
+
+using namespace spine;
+
+class SpineAssetCache::Entry : public SpineObject {
+public:
+	Vector<String> paths;
+	uint64_t hash;
+	int length;
+	/* Atlases: the directory textures are loaded from. */
+	String dir;
+	/* Skeleton data: the scale and atlas it was loaded with. The entry holds a reference to the atlas. */
+	float scale;
+	Entry *atlasEntry;
+	int references;
+	bool loading;
+	Atlas *atlas;
+	SkeletonData *skeletonData;
+	AnimationStateData *stateData;
+
+	Entry() : hash(0), length(0), scale(1), atlasEntry(NULL), references(1), loading(true), atlas(NULL),
+			  skeletonData(NULL), stateData(NULL) {
+	}
+};
+
+namespace {
+	uint64_t contentHash(const char *data, int length) {
+		uint64_t hash = 14695981039346656037ULL;
+		for (int i = 0; i < length; i++) {
+			hash ^= (unsigned char) data[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	String directory(const String &path) {
+		const char *lastForwardSlash = strrchr(path.buffer(), '/');
+		const char *lastBackwardSlash = strrchr(path.buffer(), '\\');
+		const char *lastSlash = lastForwardSlash > lastBackwardSlash ? lastForwardSlash : lastBackwardSlash;
+		if (lastSlash == path.buffer()) lastSlash++; /* Never drop starting slash. */
+		int dirLength = (int) (lastSlash ? lastSlash - path.buffer() : 0);
+		char *dir = SpineExtension::calloc<char>(dirLength + 1, __FILE__, __LINE__);
+		memcpy(dir, path.buffer(), dirLength);
+		dir[dirLength] = '\0';
+		return String(dir, true);
+	}
+
+	/* Whether the file at the path has the same contents. Called without holding the cache's lock. */
+	bool sameContents(const String &path, const MappedFile &file) {
+		MappedFile other;
+		bool same = SpineExtension::mapFile(path, other) && other.length == file.length &&
+					memcmp(other.data, file.data, file.length) == 0;
+		SpineExtension::unmapFile(other);
+		return same;
+	}
+
+	bool isBinary(const String &path) {
+		static const char extension[] = ".skel";
+		size_t length = sizeof(extension) - 1;
+		if (path.length() < length) return false;
+		const char *end = path.buffer() + path.length() - length;
+		for (size_t i = 0; i < length; i++)
+			if (tolower((unsigned char) end[i]) != extension[i]) return false;
+		return true;
+	}
+}
+
+SpineAssetCache::SpineAssetCache(TextureLoader *textureLoader) : _textureLoader(textureLoader) {
+}
+
+SpineAssetCache::~SpineAssetCache() {
+	for (size_t i = 0; i < _skeletons.size(); i++)
+		destroy(_skeletons[i]);
+	for (size_t i = 0; i < _atlases.size(); i++)
+		destroy(_atlases[i]);
+}
+
+Atlas *SpineAssetCache::acquireAtlas(const String &path) {
+	Entry *entry = acquireAtlasEntry(path);
+	return entry ? entry->atlas : NULL;
+}
+
+void SpineAssetCache::releaseAtlas(Atlas *atlas) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (size_t i = 0; i < _atlases.size(); i++) {
+		if (_atlases[i]->atlas == atlas) {
+			release(_atlases[i], lock);
+			return;
+		}
+	}
+}
+
+SkeletonData *SpineAssetCache::acquireSkeletonData(const String &path, const String &atlasPath, float scale) {
+	Entry *atlasEntry = acquireAtlasEntry(atlasPath);
+	if (!atlasEntry) return NULL;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	Entry *entry = _skeletonPaths.containsKey(path) ? _skeletonPaths[path] : NULL;
+	if (entry && (entry->atlasEntry != atlasEntry || entry->scale != scale)) entry = NULL;
+	if (!entry) {
+		lock.unlock();
+		MappedFile file;
+		if (!SpineExtension::mapFile(path, file) || file.length == 0) {
+			SpineExtension::unmapFile(file);
+			lock.lock();
+			_error = String("Unable to read skeleton file: ").append(path);
+			release(atlasEntry, lock);
+			return NULL;
+		}
+		uint64_t hash = contentHash(file.data, file.length);
+		lock.lock();
+		for (size_t i = 0; i < _skeletons.size() && !entry; i++) {
+			Entry *other = _skeletons[i];
+			if (other->hash == hash && other->length == file.length && other->atlasEntry == atlasEntry &&
+				other->scale == scale)
+				entry = other;
+		}
+		if (entry) entry = confirmContents(entry, file, lock);
+		if (!entry) {
+			/* The new entry takes over the atlas reference. Requests for it wait until it is loaded. */
+			entry = new (__FILE__, __LINE__) Entry();
+			entry->hash = hash;
+			entry->length = file.length;
+			entry->scale = scale;
+			entry->atlasEntry = atlasEntry;
+			entry->paths.add(path);
+			_skeletons.add(entry);
+			if (!_skeletonPaths.containsKey(path)) _skeletonPaths.put(path, entry);
+			lock.unlock();
+
+			SkeletonData *skeletonData;
+			String error;
+			if (isBinary(path)) {
+				SkeletonBinary binary(atlasEntry->atlas);
+				binary.setScale(scale);
+				skeletonData = binary.readSkeletonData((const unsigned char *) file.data, file.length);
+				if (!skeletonData) error = binary.getError();
+			} else {
+				SkeletonJson json(atlasEntry->atlas);
+				json.setScale(scale);
+				skeletonData = json.readSkeletonData(file.data);
+				if (!skeletonData) error = json.getError();
+			}
+			SpineExtension::unmapFile(file);
+
+			lock.lock();
+			entry->skeletonData = skeletonData;
+			if (skeletonData) entry->stateData = new (__FILE__, __LINE__) AnimationStateData(skeletonData);
+			entry->loading = false;
+			_loaded.notify_all();
+			if (!skeletonData) {
+				_error = error;
+				remove(entry);
+				release(entry, lock);
+			}
+			return skeletonData;
+		}
+		SpineExtension::unmapFile(file);
+		if (!_skeletonPaths.containsKey(path)) {
+			entry->paths.add(path);
+			_skeletonPaths.put(path, entry);
+		}
+		/* The cached skeleton data already holds a reference to the atlas. */
+		release(atlasEntry, lock);
+		entry = waitUntilLoaded(entry, lock);
+		return entry ? entry->skeletonData : NULL;
+	}
+
+	/* The cached skeleton data already holds a reference to the atlas. */
+	release(atlasEntry, lock);
+	entry = acquire(entry, lock);
+	return entry ? entry->skeletonData : NULL;
+}
+
+void SpineAssetCache::releaseSkeletonData(SkeletonData *skeletonData) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (size_t i = 0; i < _skeletons.size(); i++) {
+		if (_skeletons[i]->skeletonData == skeletonData) {
+			release(_skeletons[i], lock);
+			return;
+		}
+	}
+}
+
+AnimationStateData *SpineAssetCache::getAnimationStateData(SkeletonData *skeletonData) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	for (size_t i = 0; i < _skeletons.size(); i++)
+		if (_skeletons[i]->skeletonData == skeletonData) return _skeletons[i]->stateData;
+	return NULL;
+}
+
+size_t SpineAssetCache::getAtlasCount() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _atlases.size();
+}
+
+size_t SpineAssetCache::getSkeletonDataCount() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _skeletons.size();
+}
+
+String SpineAssetCache::getError() {
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _error;
+}
+
+SpineAssetCache::Entry *SpineAssetCache::acquireAtlasEntry(const String &path) {
+	std::unique_lock<std::mutex> lock(_mutex);
+	Entry *entry = _atlasPaths.containsKey(path) ? _atlasPaths[path] : NULL;
+	if (!entry) {
+		lock.unlock();
+		MappedFile file;
+		if (!SpineExtension::mapFile(path, file) || file.length == 0) {
+			SpineExtension::unmapFile(file);
+			lock.lock();
+			_error = String("Unable to read atlas file: ").append(path);
+			return NULL;
+		}
+		String dir = directory(path);
+		uint64_t hash = contentHash(file.data, file.length);
+		lock.lock();
+		for (size_t i = 0; i < _atlases.size() && !entry; i++) {
+			Entry *other = _atlases[i];
+			if (other->hash == hash && other->length == file.length && other->dir == dir) entry = other;
+		}
+		if (entry) entry = confirmContents(entry, file, lock);
+		if (!entry) {
+			entry = new (__FILE__, __LINE__) Entry();
+			entry->hash = hash;
+			entry->length = file.length;
+			entry->dir = dir;
+			entry->paths.add(path);
+			_atlases.add(entry);
+			_atlasPaths.put(path, entry);
+			lock.unlock();
+
+			Atlas *atlas;
+			{
+				std::lock_guard<std::mutex> textureLock(_textureMutex);
+				atlas = new (__FILE__, __LINE__) Atlas(file.data, file.length, dir.buffer(), _textureLoader);
+			}
+			SpineExtension::unmapFile(file);
+
+			lock.lock();
+			entry->atlas = atlas;
+			entry->loading = false;
+			_loaded.notify_all();
+			return entry;
+		}
+		SpineExtension::unmapFile(file);
+		if (!_atlasPaths.containsKey(path)) {
+			entry->paths.add(path);
+			_atlasPaths.put(path, entry);
+		}
+		return waitUntilLoaded(entry, lock);
+	}
+	return acquire(entry, lock);
+}
+
+SpineAssetCache::Entry *SpineAssetCache::acquire(Entry *entry, std::unique_lock<std::mutex> &lock) {
+	entry->references++;
+	return waitUntilLoaded(entry, lock);
+}
+
+/* Returns the entry once it is loaded, or releases the caller's reference and returns NULL if loading failed. */
+SpineAssetCache::Entry *SpineAssetCache::waitUntilLoaded(Entry *entry, std::unique_lock<std::mutex> &lock) {
+	while (entry->loading)
+		_loaded.wait(lock);
+	if (entry->atlas || entry->skeletonData) return entry;
+	release(entry, lock);
+	return NULL;
+}
+
+/* Compares the file with the file of an entry whose hash matched. The bytes are compared without holding the lock, so
+ * the candidate is referenced meanwhile. Returns the candidate with that reference if the contents are the same, else
+ * releases it and returns NULL. */
+SpineAssetCache::Entry *SpineAssetCache::confirmContents(Entry *candidate, const MappedFile &file, std::unique_lock<std::mutex> &lock) {
+	candidate->references++;
+	String path = candidate->paths[0];
+	lock.unlock();
+	bool same = sameContents(path, file);
+	lock.lock();
+	if (same) return candidate;
+	release(candidate, lock);
+	return NULL;
+}
+
+void SpineAssetCache::release(Entry *entry, std::unique_lock<std::mutex> &lock) {
+	if (--entry->references > 0) return;
+	remove(entry);
+	Entry *atlasEntry = entry->atlasEntry;
+	lock.unlock();
+	destroy(entry);
+	lock.lock();
+	if (atlasEntry) release(atlasEntry, lock);
+}
+
+void SpineAssetCache::remove(Entry *entry) {
+	Vector<Entry *> &entries = entry->atlasEntry ? _skeletons : _atlases;
+	HashMap<String, Entry *> &paths = entry->atlasEntry ? _skeletonPaths : _atlasPaths;
+	int index = entries.indexOf(entry);
+	if (index == -1) return;
+	entries.removeAt(index);
+	for (size_t i = 0; i < entry->paths.size(); i++) {
+		if (paths.containsKey(entry->paths[i]) && paths[entry->paths[i]] == entry) paths.remove(entry->paths[i]);
+	}
+}
+
+void SpineAssetCache::destroy(Entry *entry) {
+	delete entry->stateData;
+	delete entry->skeletonData;
+	if (entry->atlas) {
+		std::lock_guard<std::mutex> textureLock(_textureMutex);
+		delete entry->atlas;
+	}
+	delete entry;
+}
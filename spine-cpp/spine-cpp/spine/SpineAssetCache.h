@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SpineAssetCache_h
+#define Spine_SpineAssetCache_h
+
+#include <spine/Extension.h>
+#include <spine/HashMap.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+#include <spine/Vector.h>
+
+#include <condition_variable>
+#include <mutex>
+
+namespace spine {
+	class AnimationStateData;
+
+	class Atlas;
+
+	class SkeletonData;
+
+	class TextureLoader;
+
+	/// Shares loaded atlases and skeleton data between the skeletons that use them. Each asset is loaded once and
+	/// kept until its last reference is released, so creating many skeletons of the same type only costs their
+	/// Skeleton and AnimationState instances.
+	///
+	/// Assets are found by path and by content: a file with the same contents as a cached asset shares that asset,
+	/// provided atlases are in the same directory and skeleton data uses the same atlas and scale. Contents are
+	/// matched by hash, then confirmed by comparing the bytes with the cached asset's file. Assets may be
+	/// acquired and released from several threads. A request for an asset that is being loaded waits for that load.
+	/// Atlases are created and deleted one at a time, since texture loaders are rarely thread-safe.
+	class SP_API SpineAssetCache : public SpineObject {
+	public:
+		explicit SpineAssetCache(TextureLoader *textureLoader);
+
+		/// Deletes all cached assets, including those that were not released.
+		~SpineAssetCache();
+
+		/// Returns the atlas, loading it and its textures if it isn't cached. Call releaseAtlas() when done with it.
+		/// @return NULL if the file could not be read, see getError().
+		Atlas *acquireAtlas(const String &path);
+
+		void releaseAtlas(Atlas *atlas);
+
+		/// Returns the skeleton data, loading it with attachments from the atlas if it isn't cached. Paths ending in
+		/// .skel are read with SkeletonBinary, others with SkeletonJson. Cached skeleton data holds a reference to its
+		/// atlas. Call releaseSkeletonData() when done with it.
+		/// @return NULL if loading failed, see getError().
+		SkeletonData *acquireSkeletonData(const String &path, const String &atlasPath, float scale = 1);
+
+		void releaseSkeletonData(SkeletonData *skeletonData);
+
+		/// The AnimationStateData created for cached skeleton data. It is shared by everything using the skeleton
+		/// data, so mix times set on it apply to all of their AnimationStates.
+		/// @return NULL if the skeleton data isn't cached.
+		AnimationStateData *getAnimationStateData(SkeletonData *skeletonData);
+
+		size_t getAtlasCount();
+
+		size_t getSkeletonDataCount();
+
+		/// The error from the last failed acquire.
+		String getError();
+
+	private:
+		class Entry;
+
+		TextureLoader *_textureLoader;
+		Vector<Entry *> _atlases;
+		Vector<Entry *> _skeletons;
+		HashMap<String, Entry *> _atlasPaths;
+		HashMap<String, Entry *> _skeletonPaths;
+		String _error;
+		std::mutex _mutex;
+		std::mutex _textureMutex;
+		std::condition_variable _loaded;
+
+		Entry *acquireAtlasEntry(const String &path);
+
+		Entry *acquire(Entry *entry, std::unique_lock<std::mutex> &lock);
+
+		Entry *waitUntilLoaded(Entry *entry, std::unique_lock<std::mutex> &lock);
+
+		Entry *confirmContents(Entry *candidate, const MappedFile &file, std::unique_lock<std::mutex> &lock);
+
+		void release(Entry *entry, std::unique_lock<std::mutex> &lock);
+
+		void remove(Entry *entry);
+
+		void destroy(Entry *entry);
+	};
+}
+
+#endif /* Spine_SpineAssetCache_h */
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SpineString.h>
+#include <spine/DataArena.h>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+
+using namespace spine;
+
+namespace {
+	/* The characters of an atom follow its header. An atom is removed from the table when its last reference is
+	 * released. References are only added with the table locked, so an atom that has dropped to zero can't be found
+	 * again. */
+	struct Atom {
+		std::atomic<int> references;
+		Atom *next;
+		size_t hash;
+		size_t length;
+
+		char *chars() {
+			return (char *) (this + 1);
+		}
+	};
+
+	std::mutex atomMutex;
+	Atom **atomBuckets = NULL;
+	size_t atomCapacity = 0;
+	size_t atomCount = 0;
+
+	size_t hashChars(const char *chars, size_t length) {
+		uint64_t hash = 14695981039346656037ULL;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= (unsigned char) chars[i];
+			hash *= 1099511628211ULL;
+		}
+		return (size_t) hash;
+	}
+
+	inline Atom *getAtom(const char *buffer) {
+		return (Atom *) buffer - 1;
+	}
+
+	void growAtoms() {
+		size_t capacity = atomCapacity ? atomCapacity << 1 : 256;
+		Atom **buckets = SpineExtension::calloc<Atom *>(capacity, __FILE__, __LINE__);
+		for (size_t i = 0; i < atomCapacity; i++) {
+			for (Atom *atom = atomBuckets[i], *next; atom; atom = next) {
+				next = atom->next;
+				Atom *&bucket = buckets[atom->hash & (capacity - 1)];
+				atom->next = bucket;
+				bucket = atom;
+			}
+		}
+		if (atomBuckets) SpineExtension::free(atomBuckets, __FILE__, __LINE__);
+		atomBuckets = buckets;
+		atomCapacity = capacity;
+	}
+}
+
+String String::atom(const char *chars) {
+	String result;
+	if (!chars) return result;
+	size_t length = strlen(chars);
+	size_t hash = hashChars(chars, length);
+	/* Atoms may outlive the data being loaded, so they are never allocated from its DataArena. */
+	DataArena::Scope scope(NULL);
+
+	std::lock_guard<std::mutex> lock(atomMutex);
+	Atom *atom = NULL;
+	if (atomCapacity) {
+		for (atom = atomBuckets[hash & (atomCapacity - 1)]; atom; atom = atom->next) {
+			if (atom->hash == hash && atom->length == length && memcmp(atom->chars(), chars, length) == 0) {
+				atom->references.fetch_add(1, std::memory_order_relaxed);
+				break;
+			}
+		}
+	}
+	if (!atom) {
+		if (atomCount >= atomCapacity - (atomCapacity >> 2)) growAtoms();
+		void *memory = SpineExtension::alloc<char>(sizeof(Atom) + length + 1, __FILE__, __LINE__);
+		atom = new (memory) Atom();
+		atom->references.store(1, std::memory_order_relaxed);
+		atom->hash = hash;
+		atom->length = length;
+		memcpy(atom->chars(), chars, length + 1);
+		Atom *&bucket = atomBuckets[hash & (atomCapacity - 1)];
+		atom->next = bucket;
+		bucket = atom;
+		atomCount++;
+	}
+	result._length = length;
+	result._buffer = atom->chars();
+	result._atom = true;
+	return result;
+}
+
+void String::retainAtom(const char *buffer) {
+	/* The caller holds a reference, so the atom can't be removed meanwhile. */
+	getAtom(buffer)->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+void String::releaseAtom(const char *buffer) {
+	Atom *atom = getAtom(buffer);
+	int references = atom->references.load(std::memory_order_relaxed);
+	while (references > 1) {
+		if (atom->references.compare_exchange_weak(references, references - 1, std::memory_order_release,
+												   std::memory_order_relaxed))
+			return;
+	}
+
+	/* The last reference may be taken by atom() concurrently, so it is only released with the table locked. */
+	std::lock_guard<std::mutex> lock(atomMutex);
+	if (atom->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+	Atom **link = &atomBuckets[atom->hash & (atomCapacity - 1)];
+	while (*link != atom) link = &(*link)->next;
+	*link = atom->next;
+	atom->~Atom();
+	SpineExtension::free(atom, __FILE__, __LINE__);
+	if (--atomCount == 0) {
+		SpineExtension::free(atomBuckets, __FILE__, __LINE__);
+		atomBuckets = NULL;
+		atomCapacity = 0;
+	}
+}
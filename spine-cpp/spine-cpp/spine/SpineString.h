@@ -37,39 +37,49 @@
 #include <stdio.h>
 
 namespace spine {
+	/// A string that stores up to 15 characters inside the object, so short names don't allocate. Longer strings are
+	/// allocated through SpineExtension, unless they are atoms, see atom().
 	class SP_API String : public SpineObject {
 	public:
-		String() : _length(0), _buffer(NULL), _tempowner(true) {
+		String() : _length(0), _buffer(NULL), _tempowner(true), _atom(false) {
 		}
 
-		String(const char *chars, bool own = false, bool tofree = true) {
-			_tempowner = tofree;
-			if (!chars) {
-				_length = 0;
-				_buffer = NULL;
+		String(const char *chars, bool own = false, bool tofree = true) : _length(0), _buffer(NULL), _tempowner(true),
+																		   _atom(false) {
+			if (!chars) return;
+			if (!own) {
+				assign(chars, strlen(chars));
 			} else {
 				_length = strlen(chars);
-				if (!own) {
-					_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-					memcpy((void *) _buffer, chars, _length + 1);
-				} else {
-					_buffer = (char *) chars;
-				}
+				_buffer = (char *) chars;
+				_tempowner = tofree;
 			}
 		}
 
-		String(const String &other) {
-			_tempowner = true;
-			if (!other._buffer) {
-				_length = 0;
-				_buffer = NULL;
-			} else {
+		String(const String &other) : _length(0), _buffer(NULL), _tempowner(true), _atom(false) {
+			if (other._atom) {
+				retainAtom(other._buffer);
 				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
+				_buffer = other._buffer;
+				_atom = true;
+			} else if (other._buffer) {
+				assign(other._buffer, other._length);
 			}
 		}
 
+		String(String &&other) : _length(0), _buffer(NULL), _tempowner(true), _atom(false) {
+			take(other);
+		}
+
+		/// Returns the atom for the characters. Atoms with the same characters share one immutable buffer, which is
+		/// freed when the last of them is destroyed. Copying an atom doesn't allocate, and two atoms are compared by
+		/// their buffers only. Loaders make atoms of the names that are compared at runtime, like attachment names.
+		static String atom(const char *chars);
+
+		bool isAtom() const {
+			return _atom;
+		}
+
 		size_t length() const {
 			return _length;
 		}
@@ -84,20 +94,15 @@ namespace spine {
 
 		void own(const String &other) {
 			if (this == &other) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			_length = other._length;
-			_buffer = other._buffer;
-			other._length = 0;
-			other._buffer = NULL;
+			bool tempowner = _tempowner;
+			release();
+			take(other);
+			if (!_atom) _tempowner = tempowner;
 		}
 
 		void own(const char *chars) {
 			if (_buffer == chars) return;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			release();
 
 			if (!chars) {
 				_length = 0;
@@ -109,59 +114,57 @@ namespace spine {
 		}
 
 		void unown() {
+			if (_atom) releaseAtom(_buffer);
+			_atom = false;
 			_length = 0;
 			_buffer = NULL;
 		}
 
 		String &operator=(const String &other) {
 			if (this == &other) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
-			if (!other._buffer) {
+			if (other._atom) {
+				retainAtom(other._buffer);
+				release();
+				_length = other._length;
+				_buffer = other._buffer;
+				_tempowner = true;
+				_atom = true;
+			} else if (!other._buffer) {
+				release();
 				_length = 0;
 				_buffer = NULL;
 			} else {
-				_length = other._length;
-				_buffer = SpineExtension::calloc<char>(other._length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, other._buffer, other._length + 1);
+				assign(other._buffer, other._length);
 			}
 			return *this;
 		}
 
+		String &operator=(String &&other) {
+			if (this == &other) return *this;
+			release();
+			take(other);
+			return *this;
+		}
+
 		String &operator=(const char *chars) {
 			if (_buffer == chars) return *this;
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
 			if (!chars) {
+				release();
 				_length = 0;
 				_buffer = NULL;
 			} else {
-				_length = strlen(chars);
-				_buffer = SpineExtension::calloc<char>(_length + 1, __FILE__, __LINE__);
-				memcpy((void *) _buffer, chars, _length + 1);
+				assign(chars, strlen(chars));
 			}
 			return *this;
 		}
 
 		String &append(const char *chars) {
-			size_t len = strlen(chars);
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = chars == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : chars), len + 1);
+			if (chars) append(chars, strlen(chars));
 			return *this;
 		}
 
 		String &append(const String &other) {
-			size_t len = other.length();
-			size_t thisLen = _length;
-			_length = _length + len;
-			bool same = other._buffer == _buffer;
-			_buffer = SpineExtension::realloc(_buffer, _length + 1, __FILE__, __LINE__);
-			memcpy((void *) (_buffer + thisLen), (void *) (same ? _buffer : other._buffer), len + 1);
+			append(other._buffer, other._length);
 			return *this;
 		}
 
@@ -198,28 +201,26 @@ namespace spine {
             if (startIndex < 0 || startIndex >= (int)_length || length < 0 || startIndex + length > (int)_length) {
                 return String();
             }
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String result;
+            result.assign(_buffer + startIndex, length);
+            return result;
         }
 
         String substring(int startIndex) const {
             if (startIndex < 0 || startIndex >= (int)_length) {
                 return String();
             }
-            int length = (int)_length - startIndex;
-            char* subStr = SpineExtension::calloc<char>(length + 1, __FILE__, __LINE__);
-            memcpy(subStr, _buffer + startIndex, length);
-            subStr[length] = '\0';
-            return String(subStr, true, true);
+            String result;
+            result.assign(_buffer + startIndex, _length - startIndex);
+            return result;
         }
 
 		friend bool operator==(const String &a, const String &b) {
 			if (a._buffer == b._buffer) return true;
 			if (a._length != b._length) return false;
+			if (a._atom && b._atom) return false;
 			if (a._buffer && b._buffer) {
-				return strcmp(a._buffer, b._buffer) == 0;
+				return memcmp(a._buffer, b._buffer, a._length) == 0;
 			} else {
 				return false;
 			}
@@ -230,15 +231,93 @@ namespace spine {
 		}
 
 		~String() {
-			if (_buffer && _tempowner) {
-				SpineExtension::free(_buffer, __FILE__, __LINE__);
-			}
+			release();
 		}
 
 	private:
+		static const size_t InlineLength = 15;
+
 		mutable size_t _length;
 		mutable char *_buffer;
 		mutable bool _tempowner;
+		mutable bool _atom;
+		mutable char _inline[InlineLength + 1];
+
+		static void retainAtom(const char *buffer);
+
+		static void releaseAtom(const char *buffer);
+
+		void release() const {
+			if (!_buffer) return;
+			if (_atom)
+				releaseAtom(_buffer);
+			else if (_tempowner && _buffer != _inline)
+				SpineExtension::free(_buffer, __FILE__, __LINE__);
+			_atom = false;
+		}
+
+		/* Copies the characters, which may be part of this string's buffer. */
+		void assign(const char *chars, size_t length) {
+			if (length <= InlineLength) {
+				char copy[InlineLength + 1];
+				memcpy(copy, chars, length);
+				release();
+				memcpy(_inline, copy, length);
+				_inline[length] = '\0';
+				_buffer = _inline;
+			} else {
+				char *buffer = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+				memcpy(buffer, chars, length);
+				buffer[length] = '\0';
+				release();
+				_buffer = buffer;
+			}
+			_length = length;
+			_tempowner = true;
+		}
+
+		/* Takes the buffer of another string, which is left empty. Inline characters are copied. */
+		void take(const String &other) {
+			_length = other._length;
+			_tempowner = other._tempowner;
+			_atom = other._atom;
+			if (other._buffer == other._inline) {
+				memcpy(_inline, other._inline, other._length + 1);
+				_buffer = _inline;
+			} else {
+				_buffer = other._buffer;
+			}
+			other._length = 0;
+			other._buffer = NULL;
+			other._tempowner = true;
+			other._atom = false;
+		}
+
+		void append(const char *chars, size_t count) {
+			size_t length = _length + count;
+			if (length <= InlineLength) {
+				char copy[InlineLength + 1];
+				if (_length) memcpy(copy, _buffer, _length);
+				if (count) memcpy(copy + _length, chars, count);
+				release();
+				memcpy(_inline, copy, length);
+				_buffer = _inline;
+				_tempowner = true;
+			} else if (_buffer && _buffer != _inline && _tempowner && !_atom) {
+				size_t offset = chars >= _buffer && chars <= _buffer + _length ? (size_t) (chars - _buffer) : (size_t) -1;
+				_buffer = SpineExtension::realloc(_buffer, length + 1, __FILE__, __LINE__);
+				if (count) memcpy(_buffer + _length, offset != (size_t) -1 ? _buffer + offset : chars, count);
+			} else {
+				char *buffer = SpineExtension::alloc<char>(length + 1, __FILE__, __LINE__);
+				if (_length) memcpy(buffer, _buffer, _length);
+				if (count) memcpy(buffer + _length, chars, count);
+				release();
+				_buffer = buffer;
+				_tempowner = true;
+			}
+			_buffer[length] = '\0';
+			_length = length;
+		}
 	};
 }
 
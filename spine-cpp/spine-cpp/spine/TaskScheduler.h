@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated April 5, 2025. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2025, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_TaskScheduler_h
+#define Spine_TaskScheduler_h
+
+#include <spine/SpineObject.h>
+
+namespace spine {
+	/// Runs independent loader work, such as decoding animations, in parallel. Implement it to hand the work to
+	/// an engine's job system, or use ThreadTaskScheduler. Tasks allocate through SpineExtension, so the
+	/// extension's allocator must be thread-safe.
+	class SP_API TaskScheduler : public SpineObject {
+	public:
+		virtual ~TaskScheduler();
+
+		/// Calls task(index, userData) once for every index in [0, count) and returns after all calls have
+		/// completed. Calls may run concurrently and in any order.
+		virtual void parallelFor(int count, void (*task)(int index, void *userData), void *userData) = 0;
+	};
+
+	/// Runs tasks on the calling thread plus threadCount - 1 threads started for each parallelFor() call.
+	class SP_API ThreadTaskScheduler : public TaskScheduler {
+	public:
+		/// @param threadCount The number of threads to use, or 0 for the number of hardware threads.
+		explicit ThreadTaskScheduler(int threadCount = 0);
+
+		virtual ~ThreadTaskScheduler();
+
+		virtual void parallelFor(int count, void (*task)(int index, void *userData), void *userData) override;
+
+		int getThreadCount() { return _threadCount; }
+
+	private:
+		int _threadCount;
+	};
+}
+
+#endif /* Spine_TaskScheduler_h */
@@ -46,6 +46,9 @@ namespace spine {
 		Vector<int> &triangles
 		);
 
+		/// The vertex offsets into the decomposed vertices of each polygon returned by the last decompose().
+		Vector<Vector < int>* > &getConvexPolygonsIndices();
+
 	private:
 		Vector<Vector < float>* >
 		_convexPolygons;
@@ -34,6 +34,9 @@
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
 #include <assert.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
 
 namespace spine {
 	template<typename T>
@@ -45,23 +48,27 @@ namespace spine {
 		Vector() : _size(0), _capacity(0), _buffer(NULL) {
 		}
 
-		Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._capacity), _buffer(NULL) {
+		Vector(const Vector &inVector) : _size(inVector._size), _capacity(inVector._size), _buffer(NULL) {
 			if (_capacity > 0) {
 				_buffer = allocate(_capacity);
-				for (size_t i = 0; i < _size; ++i) {
-					construct(_buffer + i, inVector._buffer[i]);
-				}
+				copyConstruct(_buffer, inVector._buffer, _size);
 			}
 		}
 
+		Vector(Vector &&inVector) : _size(0), _capacity(0), _buffer(NULL) {
+			take(inVector);
+		}
+
 		~Vector() {
 			clear();
 			deallocate(_buffer);
 		}
 
 		inline void clear() {
-			for (size_t i = 0; i < _size; ++i) {
-				destroy(_buffer + (_size - 1 - i));
+			if (!std::is_trivially_destructible<T>::value) {
+				for (size_t i = 0; i < _size; ++i) {
+					destroy(_buffer + (_size - 1 - i));
+				}
 			}
 
 			_size = 0;
@@ -78,16 +85,12 @@ namespace spine {
 		inline void setSize(size_t newSize, const T &defaultValue) {
 			assert(newSize >= 0);
 			size_t oldSize = _size;
-			_size = newSize;
 			if (_capacity < newSize) {
-				if (_capacity == 0) {
-					_capacity = _size;
-				} else {
-					_capacity = (int) (_size * 1.75f);
-				}
-				if (_capacity < 8) _capacity = 8;
-				_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
+				size_t capacity = _capacity == 0 ? newSize : (size_t) (newSize * 1.75f);
+				if (capacity < 8) capacity = 8;
+				reallocate(capacity);
 			}
+			_size = newSize;
 			if (oldSize < _size) {
 				for (size_t i = oldSize; i < _size; i++) {
 					construct(_buffer + i, defaultValue);
@@ -99,10 +102,11 @@ namespace spine {
 			}
 		}
 
+		/// Grows the buffer to exactly newCapacity elements, if it is smaller. Call this before adding a known number of
+		/// elements, so the buffer is allocated once and has no unused space.
 		inline void ensureCapacity(size_t newCapacity = 0) {
 			if (_capacity >= newCapacity) return;
-			_capacity = newCapacity;
-			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
+			reallocate(newCapacity);
 		}
 
 		inline void add(const T &inValue) {
@@ -111,23 +115,31 @@ namespace spine {
 				// When we reallocate, the reference becomes invalid.
 				// We thus need to create a defensive copy before
 				// reallocating.
-				T valueCopy = inValue;
-				_capacity = (int) (_size * 1.75f);
-				if (_capacity < 8) _capacity = 8;
-				_buffer = spine::SpineExtension::realloc<T>(_buffer, _capacity, __FILE__, __LINE__);
-				construct(_buffer + _size++, valueCopy);
+				T valueCopy(inValue);
+				grow();
+				construct(_buffer + _size++, std::move(valueCopy));
 			} else {
 				construct(_buffer + _size++, inValue);
 			}
 		}
 
-		inline void addAll(const Vector<T> &inValue) {
-			ensureCapacity(this->size() + inValue.size());
-			for (size_t i = 0; i < inValue.size(); i++) {
-				add(inValue[i]);
+		inline void add(T &&inValue) {
+			if (_size == _capacity) {
+				T valueCopy(std::move(inValue));
+				grow();
+				construct(_buffer + _size++, std::move(valueCopy));
+			} else {
+				construct(_buffer + _size++, std::move(inValue));
 			}
 		}
 
+		inline void addAll(const Vector<T> &inValue) {
+			size_t count = inValue.size();
+			ensureCapacity(_size + count);
+			copyConstruct(_buffer + _size, inValue._buffer, count);
+			_size += count;
+		}
+
 		inline void clearAndAddAll(const Vector<T> &inValue) {
 			this->clear();
 			this->addAll(inValue);
@@ -138,12 +150,13 @@ namespace spine {
 
 			--_size;
 
-			if (inIndex != _size) {
-				for (size_t i = inIndex; i < _size; ++i) {
-					T tmp(_buffer[i]);
-					_buffer[i] = _buffer[i + 1];
-					_buffer[i + 1] = tmp;
-				}
+			if (std::is_trivially_copyable<T>::value) {
+				memmove((void *) (_buffer + inIndex), (void *) (_buffer + inIndex + 1), (_size - inIndex) * sizeof(T));
+				return;
+			}
+
+			for (size_t i = inIndex; i < _size; ++i) {
+				_buffer[i] = std::move(_buffer[i + 1]);
 			}
 
 			destroy(_buffer + _size);
@@ -206,15 +219,29 @@ namespace spine {
 			return *this;
 		}
 
+		Vector &operator=(Vector &&inVector) {
+			if (this != &inVector) {
+				clear();
+				take(inVector);
+			}
+			return *this;
+		}
+
 		inline T *buffer() {
 			return _buffer;
 		}
 
-	private:
+	protected:
 		size_t _size;
 		size_t _capacity;
 		T *_buffer;
 
+		/// The storage of an InlineVector, which is never freed or reallocated, or NULL.
+		virtual T *getInlineBuffer() {
+			return NULL;
+		}
+
+	private:
 		inline T *allocate(size_t n) {
 			assert(n > 0);
 
@@ -226,20 +253,122 @@ namespace spine {
 		}
 
 		inline void deallocate(T *buffer) {
-			if (_buffer) {
+			if (buffer && buffer != getInlineBuffer()) {
 				SpineExtension::free(buffer, __FILE__, __LINE__);
 			}
 		}
 
+		inline void grow() {
+			size_t capacity = (size_t) (_size * 1.75f);
+			reallocate(capacity < 8 ? 8 : capacity);
+		}
+
+		/* Trivially copyable elements are moved by realloc. Others are move constructed into a new buffer, so elements
+		 * that point into themselves, like an InlineVector, stay valid. */
+		void reallocate(size_t newCapacity) {
+			T *inlineBuffer = getInlineBuffer();
+			if (std::is_trivially_copyable<T>::value && (!_buffer || _buffer != inlineBuffer)) {
+				_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
+			} else {
+				T *buffer = SpineExtension::alloc<T>(newCapacity, __FILE__, __LINE__);
+				for (size_t i = 0; i < _size; ++i) {
+					construct(buffer + i, std::move(_buffer[i]));
+					destroy(_buffer + i);
+				}
+				deallocate(_buffer);
+				_buffer = buffer;
+			}
+			_capacity = newCapacity;
+		}
+
+		/* Takes the elements of a vector, which is left empty. Elements in an inline buffer can't be taken and are
+		 * moved instead. */
+		void take(Vector &inVector) {
+			T *inlineBuffer = inVector.getInlineBuffer();
+			if (inVector._buffer && inVector._buffer == inlineBuffer) {
+				ensureCapacity(inVector._size);
+				for (size_t i = 0; i < inVector._size; ++i) {
+					construct(_buffer + i, std::move(inVector._buffer[i]));
+				}
+				_size = inVector._size;
+				inVector.clear();
+				return;
+			}
+			deallocate(_buffer);
+			_size = inVector._size;
+			_capacity = inVector._capacity;
+			_buffer = inVector._buffer;
+			inVector._size = 0;
+			inVector._capacity = 0;
+			inVector._buffer = NULL;
+		}
+
+		inline void copyConstruct(T *buffer, const T *values, size_t count) {
+			if (std::is_trivially_copyable<T>::value) {
+				if (count) memcpy((void *) buffer, (const void *) values, count * sizeof(T));
+				return;
+			}
+			for (size_t i = 0; i < count; ++i) {
+				construct(buffer + i, values[i]);
+			}
+		}
+
 		inline void construct(T *buffer, const T &val) {
 			new(buffer) T(val);
 		}
 
+		inline void construct(T *buffer, T &&val) {
+			new(buffer) T(std::move(val));
+		}
+
 		inline void destroy(T *buffer) {
 			buffer->~T();
 		}
 
 	};
+
+	/// A Vector with room for N elements inside the object, so it doesn't allocate until it holds more. Use it for
+	/// members that usually hold only a few elements. It can be passed on as a Vector<T>.
+	template<typename T, size_t N>
+	class SP_API InlineVector : public Vector<T> {
+	public:
+		InlineVector() {
+			this->_buffer = getInlineBuffer();
+			this->_capacity = N;
+		}
+
+		InlineVector(const InlineVector &inVector) : InlineVector() {
+			this->addAll(inVector);
+		}
+
+		InlineVector(const Vector<T> &inVector) : InlineVector() {
+			this->addAll(inVector);
+		}
+
+		~InlineVector() {
+			/* The base destructor can't tell the inline buffer apart anymore. */
+			this->clear();
+			if (this->_buffer == getInlineBuffer()) this->_buffer = NULL;
+		}
+
+		InlineVector &operator=(const InlineVector &inVector) {
+			Vector<T>::operator=(inVector);
+			return *this;
+		}
+
+		InlineVector &operator=(const Vector<T> &inVector) {
+			Vector<T>::operator=(inVector);
+			return *this;
+		}
+
+	protected:
+		virtual T *getInlineBuffer() override {
+			return (T *) _storage;
+		}
+
+	private:
+		alignas(T) char _storage[N * sizeof(T)];
+	};
 }
 
 #endif /* Spine_Vector_h */
@@ -34,6 +34,8 @@
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
 
+#include <atomic>
+
 using namespace spine;
 
 RTTI_IMPL(VertexAttachment, Attachment)
@@ -155,7 +157,8 @@ void VertexAttachment::setTimelineAttachment(Attachment *attachment) {
 }
 
 int VertexAttachment::getNextID() {
-	static int nextID = 0;
+	/* Skeleton data may be loaded on several threads at once, see SpineAssetCache. */
+	static std::atomic<int> nextID(0);
 	return nextID++;
 }
 
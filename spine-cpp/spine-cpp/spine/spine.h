@@ -30,7 +30,9 @@
 #ifndef SPINE_SPINE_H_
 #define SPINE_SPINE_H_
 
+#include <spine/AllocationProfiler.h>
 #include <spine/Animation.h>
+#include <spine/AnimationDecoder.h>
 #include <spine/AnimationState.h>
 #include <spine/AnimationStateData.h>
 #include <spine/Atlas.h>
@@ -49,11 +51,13 @@
 #include <spine/ConstraintData.h>
 #include <spine/ContainerUtil.h>
 #include <spine/CurveTimeline.h>
+#include <spine/DataArena.h>
 #include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
 #include <spine/EventData.h>
 #include <spine/EventTimeline.h>
+#include <spine/FrameArena.h>
 #include <spine/Extension.h>
 #include <spine/HasRendererObject.h>
 #include <spine/HashMap.h>
@@ -66,6 +70,7 @@
 #include <spine/LinkedMesh.h>
 #include <spine/MathUtil.h>
 #include <spine/MeshAttachment.h>
+#include <spine/NameIndex.h>
 #include <spine/MixBlend.h>
 #include <spine/MixDirection.h>
 #include <spine/PathAttachment.h>
@@ -79,6 +84,7 @@
 #include <spine/PhysicsConstraintData.h>
 #include <spine/PointAttachment.h>
 #include <spine/Pool.h>
+#include <spine/PoolingSpineExtension.h>
 #include <spine/PositionMode.h>
 #include <spine/Property.h>
 #include <spine/RTTI.h>
@@ -88,6 +94,7 @@
 #include <spine/ScaleTimeline.h>
 #include <spine/ShearTimeline.h>
 #include <spine/Skeleton.h>
+#include <spine/SkeletonBatcher.h>
 #include <spine/SkeletonBinary.h>
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonClipping.h>
@@ -98,8 +105,10 @@
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SpacingMode.h>
+#include <spine/SpineAssetCache.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
+#include <spine/TaskScheduler.h>
 #include <spine/TextureLoader.h>
 #include <spine/Timeline.h>
 #include <spine/TransformConstraint.h>